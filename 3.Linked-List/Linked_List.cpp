@@ -54,7 +54,12 @@ private:
 public:
 	bool isEmpty() const {return size == 0;}
 	// Default Constructor
-	Linked_List(): size(0) {}
+	Linked_List(): first(NULL), last(NULL), size(0) {}
+	// Move Constructor (steals the nodes of other, no copies)
+	Linked_List(Linked_List&& other)
+		: first(other.first), last(other.last), size(other.size) {
+		other._release();
+	}
 	// add element at the bottom
 	void push_back(const T data) {
 		Node* newNode = new Node(data);
@@ -125,6 +130,7 @@ public:
 		T temp_data = del_node->data;
 		temp->next = del_node->next;
 		delete del_node;
+		size--;
 		return temp_data;
 	}
 	int remove(const T& ELEMENT) {
@@ -203,10 +209,78 @@ public:
 		return -1;
 	}
 	bool contains(const T& ELEMENT) const {	return indexOf(ELEMENT) != -1;}
+
+	// Move all nodes of other to the end of this list O(1)
+	void append_list(Linked_List&& other) {
+		splice(size, other);
+	}
+	// Move all nodes of other in front of the given index, leaving other empty
+	// Walking to the index is O(index), relinking itself is O(1)
+	void splice(size_t index, Linked_List& other) {
+		if (index > size) throw std::invalid_argument("Invalid Argument");
+		if (&other == this or other.isEmpty()) return;
+		if (isEmpty()) {
+			first = other.first;
+			last = other.last;
+		}	else if (index == 0) {
+			other.last->next = first;
+			first = other.first;
+		}	else if (index == size) {
+			last->next = other.first;
+			last = other.last;
+		}	else {
+			Node * temp = first;
+			while (--index) temp = temp->next;
+			other.last->next = temp->next;
+			temp->next = other.first;
+		}
+		size += other.size;
+		other._release();
+		return;
+	}
+	// Cut the list at index, this keeps [0, index) and the returned list
+	// owns [index, size). Nodes are relinked, not copied.
+	Linked_List split_at(size_t index) {
+		if (index > size) throw std::invalid_argument("Invalid Argument");
+		Linked_List tail;
+		if (index == size) return tail;
+		if (index == 0) {
+			std::swap(tail.first, first);
+			std::swap(tail.last, last);
+			std::swap(tail.size, size);
+			return tail;
+		}
+		Node * temp = first;
+		size_t i = index;
+		while (--i) temp = temp->next;
+		tail.first = temp->next;
+		tail.last = last;
+		tail.size = size - index;
+		temp->next = NULL;
+		last = temp;
+		size = index;
+		return tail;
+	}
+	// Merge the sorted list other into this sorted list O(n + m),
+	// leaving other empty
+	void merge(Linked_List& other) {
+		if (&other == this or other.isEmpty()) return;
+		if (isEmpty()) return splice(0, other);
+		first = _merge(first, other.first);
+		size += other.size;
+		other._release();
+		return;
+	}
 	Iterator begin() const {return Iterator(first);}
 	Iterator end() const {return Iterator(NULL);}
 
 private:
+	// Forget the nodes without deleting them (ownership moved elsewhere)
+	void _release() {
+		first = last = NULL;
+		size = 0;
+	}
+
 	// Sort
 
 	Node* _split(Node* head) {
@@ -329,5 +403,17 @@ int main() {
 	list_int.remove(99); // Will remove all ocurrences of the element
 	std::cout << list_int << '\n';
 
+	Linked_List<int> odds, evens;
+	for (int i = 1; i < 10; i += 2) odds.push_back(i);
+	for (int i = 0; i < 10; i += 2) evens.push_back(i);
+	odds.merge(evens);
+	std::cout << odds << '\n';
+	Linked_List<int> upper = odds.split_at(5);
+	std::cout << odds << "| " << upper << '\n';
+	upper.splice(2, list_int);
+	std::cout << upper << '\n';
+	odds.append_list(std::move(upper));
+	std::cout << odds << '\n';
+
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,378 @@
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <cstdint>
+
+//Doubly-linked-list stored in one contiguous array
+// Nodes live in a std::vector and are linked by 32-bit indices instead of
+// 64-bit pointers, so for small T a node is about half the size of a
+// Linked_List node and there is no per-node allocation. Removed slots are
+// kept on an internal freelist (chained through m_next) and reused by the
+// next push.
+template<typename T>
+class Compact_Linked_List {
+private:
+	static const uint32_t NIL = UINT32_MAX;
+
+	class Node	{
+		T m_data;
+		uint32_t m_next, m_previous;
+		friend class Compact_Linked_List<T>;
+	public:
+		Node(const T& data, uint32_t next, uint32_t previous)
+			: m_data(data), m_next(next), m_previous(previous)
+		{}
+	};
+
+	class Iterator {
+	private:
+		Compact_Linked_List* m_list;
+		uint32_t m_index;
+	public:
+		Iterator(Compact_Linked_List* list, uint32_t index)
+			: m_list(list), m_index(index)
+		{}
+		Iterator operator++() {
+			m_index = m_list->_advance(m_index);
+			return *this;
+		}
+		Iterator operator++(int) {
+			Iterator temp = *this;
+			m_index = m_list->_advance(m_index);
+			return temp;
+		}
+		Iterator operator--() {
+			m_index = m_list->m_nodes[m_index].m_previous;
+			return *this;
+		}
+		Iterator operator--(int) {
+			Iterator temp = *this;
+			m_index = m_list->m_nodes[m_index].m_previous;
+			return temp;
+		}
+		T* operator->() const {
+			return &(m_list->m_nodes[m_index].m_data);
+		}
+		T& operator*() const {
+			return m_list->m_nodes[m_index].m_data;
+		}
+		bool operator==(const Iterator& other) const {
+			return m_index == other.m_index;
+		}
+		bool operator!=(const Iterator& other) const {
+			return m_index != other.m_index;
+		}
+	};
+
+private:
+	size_t m_size;
+	uint32_t m_head, m_tail, m_free;
+	std::vector<Node> m_nodes;
+
+	// Step to the next node and prefetch the one after it, so a traversal
+	// keeps one node in flight even when the nodes are not laid out in order
+	uint32_t _advance(uint32_t index) const {
+		uint32_t next = m_nodes[index].m_next;
+#if defined(__GNUC__)
+		if (next != NIL) __builtin_prefetch(&m_nodes[m_nodes[next].m_next == NIL ? next : m_nodes[next].m_next]);
+#endif
+		return next;
+	}
+
+	uint32_t _allocate(const T& ELEMENT, uint32_t next, uint32_t previous) {
+		if (m_free == NIL) {
+			if (m_nodes.size() == NIL) throw std::length_error("List is full");
+			m_nodes.emplace_back(ELEMENT, next, previous);
+			return m_nodes.size() - 1;
+		}
+		uint32_t index = m_free;
+		m_free = m_nodes[index].m_next;
+		m_nodes[index].m_data = ELEMENT;
+		m_nodes[index].m_next = next;
+		m_nodes[index].m_previous = previous;
+		return index;
+	}
+
+	void _deallocate(uint32_t index) {
+		// Drop whatever the element owns, the slot itself is reused later
+		m_nodes[index].m_data = T();
+		m_nodes[index].m_previous = NIL;
+		m_nodes[index].m_next = m_free;
+		m_free = index;
+	}
+
+	T _remove(uint32_t other) { //Remove an arbritary node from the linked list O(1)
+		Node& node = m_nodes[other];
+		if (node.m_previous != NIL) m_nodes[node.m_previous].m_next = node.m_next;
+		else m_head = node.m_next;
+		if (node.m_next != NIL) m_nodes[node.m_next].m_previous = node.m_previous;
+		else m_tail = node.m_previous;
+
+		T temp_data = node.m_data;
+		_deallocate(other);
+		m_size--;
+		return temp_data;
+	}
+
+	// The sort works on the forward links only, _merge_sort fixes the
+	// backward links once the order is final
+	uint32_t _merge(uint32_t first, uint32_t second) {
+		uint32_t head = NIL, last = NIL;
+		while (first != NIL and second != NIL) {
+			uint32_t& smaller = m_nodes[second].m_data < m_nodes[first].m_data ? second : first;
+			if (last == NIL) head = smaller;
+			else m_nodes[last].m_next = smaller;
+			last = smaller;
+			smaller = m_nodes[smaller].m_next;
+		}
+		uint32_t rest = first != NIL ? first : second;
+		if (last == NIL) head = rest;
+		else m_nodes[last].m_next = rest;
+		return head;
+	}
+
+	uint32_t _split(uint32_t head) {
+		uint32_t fast = head, slow = head;
+
+		while (m_nodes[fast].m_next != NIL and m_nodes[m_nodes[fast].m_next].m_next != NIL) {
+			fast = m_nodes[m_nodes[fast].m_next].m_next;
+			slow = m_nodes[slow].m_next;
+		}
+
+		fast = m_nodes[slow].m_next;
+		m_nodes[slow].m_next = NIL;
+		return fast;
+	}
+
+	uint32_t _merge_sort(uint32_t head) {
+		//Base Case
+		if (head == NIL or m_nodes[head].m_next == NIL)
+			return head;
+
+		// Recursive Case
+		uint32_t second = _split(head);
+		head = _merge_sort(head);
+		second = _merge_sort(second);
+		return _merge(head, second);
+	}
+
+public:
+	Compact_Linked_List()
+		: m_size(0), m_head(NIL), m_tail(NIL), m_free(NIL) {}
+
+	bool isEmpty() const {
+		return m_size == 0;
+	}
+
+	size_t size() const {
+		return m_size;
+	}
+
+	// Reserve room for capacity nodes up front
+	void reserve(size_t capacity) {
+		m_nodes.reserve(capacity);
+	}
+
+	void push_back(const T& ELEMENT) {
+		uint32_t index = _allocate(ELEMENT, NIL, m_tail);
+		if (isEmpty()) m_head = index;
+		else m_nodes[m_tail].m_next = index;
+		m_tail = index;
+		m_size++;
+	}
+
+	void push_front(const T& ELEMENT) {
+		uint32_t index = _allocate(ELEMENT, m_head, NIL);
+		if (isEmpty()) m_tail = index;
+		else m_nodes[m_head].m_previous = index;
+		m_head = index;
+		m_size++;
+	}
+
+	T pop_back() {
+		if (isEmpty()) throw std::runtime_error("Empty List");
+		return _remove(m_tail);
+	}
+
+	T pop_front() {
+		if (isEmpty()) throw std::runtime_error("Empty List");
+		return _remove(m_head);
+	}
+
+	int remove(const T& ELEMENT) {
+		int count = 0;
+		uint32_t temp = m_head, next;
+		while (temp != NIL) {
+			next = _advance(temp);
+			if (m_nodes[temp].m_data == ELEMENT) {
+				_remove(temp);
+				count++;
+			}
+			temp = next;
+		}
+		return count;
+	}
+
+	T remove_at(size_t index) {
+		if (index >= m_size) throw std::invalid_argument("Invalid Argument");
+
+		uint32_t temp;
+		size_t i = 0;
+		if (index < m_size / 2)
+			for (i = 0, temp = m_head; i < index; i++)
+				temp = m_nodes[temp].m_next;
+		else
+			for (i = m_size - 1, temp = m_tail; i > index; i--)
+				temp = m_nodes[temp].m_previous;
+
+		return _remove(temp);
+	}
+
+	T peak_first() const {
+		if (isEmpty()) throw std::runtime_error("Empty List");
+		return m_nodes[m_head].m_data;
+	}
+
+	T peak_last() const {
+		if (isEmpty()) throw std::runtime_error("Empty List");
+		return m_nodes[m_tail].m_data;
+	}
+
+	int indexOf(const T& ELEMENT) const {
+		int index = 0;
+		uint32_t temp = m_head;
+		while (temp != NIL) {
+			if (m_nodes[temp].m_data == ELEMENT)
+				return index;
+			index++;
+			temp = _advance(temp);
+		}
+		return -1;
+	}
+
+	bool contains(const T& ELEMENT) const {
+		return indexOf(ELEMENT) != -1;
+	}
+
+	void reverse() {
+		// Every node just trades its forward and backward links
+		uint32_t current = m_head;
+		while (current != NIL) {
+			Node& node = m_nodes[current];
+			std::swap(node.m_next, node.m_previous);
+			current = node.m_previous;
+		}
+		std::swap(m_head, m_tail);
+	}
+
+	void sort() {
+		if (isEmpty()) return;
+		m_head = _merge_sort(m_head);
+
+		// Rebuild the backward links and the tail
+		uint32_t previous = NIL;
+		for (uint32_t current = m_head; current != NIL; current = m_nodes[current].m_next) {
+			m_nodes[current].m_previous = previous;
+			previous = current;
+		}
+		m_tail = previous;
+	}
+
+	// Rewrite the array in list order and drop the freelist, after which a
+	// traversal is a sequential scan of the array
+	void compact() {
+		std::vector<Node> ordered;
+		ordered.reserve(m_size);
+		uint32_t index = 0;
+		for (uint32_t current = m_head; current != NIL; current = _advance(current), index++)
+			ordered.emplace_back(m_nodes[current].m_data, index + 1, index == 0 ? NIL : index - 1);
+		if (!ordered.empty()) ordered.back().m_next = NIL;
+		m_nodes.swap(ordered);
+		m_free = NIL;
+		m_head = isEmpty() ? NIL : 0;
+		m_tail = isEmpty() ? NIL : m_size - 1;
+	}
+
+	void clear() {
+		m_nodes.clear();
+		m_head = m_tail = m_free = NIL;
+		m_size = 0;
+	}
+
+	Iterator begin() {
+		return Iterator(this, m_head);
+	}
+
+	Iterator end() {
+		return Iterator(this, NIL);
+	}
+
+	std::string to_string() const {
+		std::stringstream out;
+		out << "{ ";
+		if (isEmpty()) out << " }";
+		else {
+			uint32_t temp = m_head;
+			while (temp != NIL) {
+				out << m_nodes[temp].m_data;
+				temp = _advance(temp);
+				if (temp != NIL) out << " <----> ";
+			}
+			out << " }";
+		}
+		return out.str();
+	}
+
+	friend std::ostream& operator <<(std::ostream& out, const Compact_Linked_List<T>& other) {
+		out << other.to_string();
+		return out;
+	}
+};
+
+int main() {
+	Compact_Linked_List<int> intList;
+	intList.push_back(69);
+	intList.push_back(69);
+	intList.push_front(9);
+	intList.push_front(9);
+	intList.push_back(98);
+	intList.push_back(98);
+	std::cout << intList << '\n';
+	std::cout << intList.remove(69) << ' ' << intList.remove(77) << '\n';
+	std::cout << intList << '\n';
+	intList.remove_at(1);
+	std::cout << intList << '\n';
+	intList.reverse();
+	std::cout << intList << '\n';
+	intList.clear();
+	intList.push_back(56);
+	intList.push_back(98);
+	intList.push_back(9832);
+	intList.push_back(532);
+	intList.push_back(69);
+	intList.push_back(-9869);
+	intList.pop_front();
+	intList.push_front(12);
+	std::cout << intList << '\n';
+	intList.sort();
+	std::cout << intList << '\n';
+	std::cout << intList.peak_first() << ' ' << intList.peak_last() << '\n';
+	intList.reverse();
+	std::cout << intList << '\n';
+	intList.compact();
+	for (auto x : intList)
+		std::cout << x << ' ';
+	std::cout << '\n';
+
+	std::cout << "\n=========================\n";
+
+	Compact_Linked_List<std::string> strList;
+	strList.push_back("Irtaza");
+	strList.push_back("Butt");
+	strList.push_front("Ahmad");
+	strList.push_back("Malik");
+	std::cout << strList << "\n";
+	strList.sort();
+	std::cout << strList << "\n";
+	std::cout << strList.pop_back() << ' ' << strList.indexOf("Butt") << "\n";
+}
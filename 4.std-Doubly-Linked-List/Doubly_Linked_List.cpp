@@ -1,28 +1,42 @@
 #include <iostream>
 #include <sstream>
 #include <set>
+#include <unordered_map>
+#include <iterator>
+#include <vector>
+#include <initializer_list>
+
+template<typename K, typename V>
+class LRUCache;
 
 //Doubly-linked-list
 template<typename T>
 class Linked_List {
 private:
+	class Block;
+
 	class Node	{
 		T m_data;
 		Node *m_next, *m_previous;
+		// The block this node was built in, nullptr if it came from new
+		Block* m_block;
 		friend class Linked_List<T>;
+		template<typename K, typename V>
+		friend class LRUCache;
 	public:
 		Node()
-			: m_next(nullptr), m_previous(nullptr)
+			: m_next(nullptr), m_previous(nullptr), m_block(nullptr)
 		{}
 
 		Node(const T& data, Node* next, Node* previous)
-			: m_data(data), m_next(next), m_previous(previous)
+			: m_data(data), m_next(next), m_previous(previous), m_block(nullptr)
 		{}
 	};
 
 	class Iterator {
 	private:
 		Node* m_ptr;
+		friend class Linked_List<T>;
 	public:
 		Iterator(Node* ptr)
 			: m_ptr(ptr)
@@ -59,10 +73,44 @@ private:
 		}
 	};
 
+	// A run of nodes allocated in one go by the range constructor. Its nodes
+	// can end up in any list through splice/merge/split_at, so instead of a
+	// list owning it, every node points at its block and the block counts
+	// its live nodes. The memory goes back as soon as the last one is freed.
+	class Block {
+	public:
+		Node* m_nodes;
+		size_t m_live;
+		explicit Block(size_t count)
+			: m_nodes(static_cast<Node*>(::operator new(count * sizeof(Node)))), m_live(0)
+		{}
+		~Block() {
+			::operator delete(m_nodes);
+		}
+	};
+
 private:
+	template<typename K, typename V>
+	friend class LRUCache;
+
 	size_t m_size;
 	Node *m_head, *m_tail;
 
+	static void _release_block(Block* block) {
+		if (--block->m_live == 0) delete block;
+	}
+
+	// Free a node whether it came from new or from a block O(1)
+	static void _delete_node(Node* node) {
+		Block* block = node->m_block;
+		if (block == nullptr) {
+			delete node;
+			return;
+		}
+		node->~Node();
+		_release_block(block);
+	}
+
 	T _remove(Node* other) { //Remove an arbritary node from the linked list O(1)
 		// checks if its m_head
 		if (other->m_previous == nullptr) return pop_front();
@@ -74,11 +122,64 @@ private:
 		other->m_previous->m_next = other->m_next;
 
 		T temp_data = other->m_data;
-		delete other;
+		_delete_node(other);
 		m_size--;
 		return temp_data;
 	}
 
+	// Link the chain first...last in front of position (nullptr means the end) O(1)
+	void _link_before(Node* position, Node* first, Node* last) {
+		if (position == nullptr) {
+			first->m_previous = m_tail;
+			if (m_tail != nullptr) m_tail->m_next = first;
+			else m_head = first;
+			m_tail = last;
+		}	else	{
+			first->m_previous = position->m_previous;
+			last->m_next = position;
+			if (position->m_previous != nullptr) position->m_previous->m_next = first;
+			else m_head = first;
+			position->m_previous = last;
+		}
+	}
+
+	// Detach an arbritary node without deleting it O(1)
+	void _unlink(Node* other) {
+		if (other->m_previous != nullptr) other->m_previous->m_next = other->m_next;
+		else m_head = other->m_next;
+		if (other->m_next != nullptr) other->m_next->m_previous = other->m_previous;
+		else m_tail = other->m_previous;
+		other->m_next = other->m_previous = nullptr;
+		m_size--;
+	}
+
+	// Relink an existing node at the front, no allocation and no copy O(1)
+	void _move_to_front(Node* other) {
+		if (other == m_head) return;
+		_unlink(other);
+		_link_before(m_head, other, other);
+		m_size++;
+	}
+
+	// Walk to the node at index from whichever end is closer
+	Node* _node_at(size_t index) const {
+		Node* temp;
+		size_t i = 0;
+		if (index < m_size / 2)
+			for (i = 0, temp = m_head; i < index; i++)
+				temp = temp->m_next;
+		else
+			for (i = m_size - 1, temp = m_tail; i > index; i--)
+				temp = temp->m_previous;
+		return temp;
+	}
+
+	// Forget the nodes without deleting them (ownership moved elsewhere)
+	void _release() {
+		m_head = m_tail = nullptr;
+		m_size = 0;
+	}
+
 	Node* _merge(Node *first, Node *second) {
 		Node dummy;
 		Node *last = &dummy;
@@ -144,7 +245,45 @@ private:
 	}
 public:
 	Linked_List()
-		: m_size(0) {}
+		: m_size(0), m_head(nullptr), m_tail(nullptr) {}
+
+	// Steals the nodes of other, no copies
+	Linked_List(Linked_List&& other)
+		: m_size(other.m_size), m_head(other.m_head), m_tail(other.m_tail) {
+		other._release();
+	}
+
+	// Bulk construction: all nodes come from a single allocation instead of
+	// one new per element. Needs forward iterators to size the block.
+	template<typename Iter>
+	Linked_List(Iter first, Iter last)
+		: m_size(0), m_head(nullptr), m_tail(nullptr) {
+		size_t count = std::distance(first, last);
+		if (count == 0) return;
+		Block* block = new Block(count);
+		Node* nodes = block->m_nodes;
+		// Held while building, so the block outlives a constructor throwing
+		block->m_live = 1;
+		try {
+			for (; first != last; ++first, m_size++) {
+				new(&nodes[m_size]) Node(*first, nullptr, m_tail);
+				nodes[m_size].m_block = block;
+				block->m_live++;
+				if (m_tail != nullptr) m_tail->m_next = &nodes[m_size];
+				else m_head = &nodes[m_size];
+				m_tail = &nodes[m_size];
+			}
+		}	catch (...)	{
+			// No destructor runs for a half built object, undo by hand
+			clear();
+			_release_block(block);
+			throw;
+		}
+		_release_block(block);
+	}
+
+	Linked_List(std::initializer_list<T> elements)
+		: Linked_List(elements.begin(), elements.end()) {}
 
 	bool isEmpty() const {
 		return m_size == 0;
@@ -175,13 +314,15 @@ public:
 	T pop_back() {
 		if (isEmpty()) throw std::runtime_error("Empty List");
 		T temp_data = m_tail->m_data;
+		Node* temp = m_tail;
 		m_tail = m_tail->m_previous;
 
-		delete m_tail->m_next;
+		_delete_node(temp);
 
-		m_tail->m_next = nullptr;
 		m_size--;
+		// if list had only one element
 		if (isEmpty()) m_head = nullptr;
+		else m_tail->m_next = nullptr;
 
 		return temp_data;
 	}
@@ -189,13 +330,15 @@ public:
 	T pop_front() {
 		if (isEmpty()) throw std::runtime_error("Empty List");
 		T temp_data = m_head->m_data;
+		Node* temp = m_head;
 		m_head = m_head->m_next;
 
-		delete m_head->m_previous;
-		m_head->m_previous = nullptr;
+		_delete_node(temp);
+
 		m_size--;
 		// if list had only one element
 		if (isEmpty()) m_tail = nullptr;
+		else m_head->m_previous = nullptr;
 
 		return temp_data;
 	}
@@ -216,17 +359,55 @@ public:
 
 	T remove_at(size_t index) {
 		if (index >= m_size) throw std::invalid_argument("Invalid Argument");
+		return _remove(_node_at(index));
+	}
 
-		Node* temp;
-		size_t i = 0;
-		if (index < m_size / 2)
-			for (i = 0, temp = m_head; i < index; i++)
-				temp = temp->m_next;
-		else
-			for (i = m_size - 1, temp = m_tail; i > index; i--)
-				temp = temp->m_previous;
+	// Move all nodes of other in front of position, leaving other empty O(1)
+	void splice(Iterator position, Linked_List& other) {
+		if (&other == this or other.isEmpty()) return;
+		_link_before(position.m_ptr, other.m_head, other.m_tail);
+		m_size += other.m_size;
+		other._release();
+	}
+
+	// Same as above but the position is given by index O(min(index, size - index))
+	void splice(size_t index, Linked_List& other) {
+		if (index > m_size) throw std::invalid_argument("Invalid Argument");
+		splice(Iterator(index == m_size ? nullptr : _node_at(index)), other);
+	}
 
-		return _remove(temp);
+	// Move all nodes of other to the end of this list O(1)
+	void append_list(Linked_List&& other) {
+		splice(end(), other);
+	}
+
+	// Cut the list at index, this keeps [0, index) and the returned list
+	// owns [index, size). Nodes are relinked, not copied.
+	Linked_List split_at(size_t index) {
+		if (index > m_size) throw std::invalid_argument("Invalid Argument");
+		Linked_List tail;
+		if (index == m_size) return tail;
+		Node* cut = _node_at(index);
+		tail.m_head = cut;
+		tail.m_tail = m_tail;
+		tail.m_size = m_size - index;
+		m_tail = cut->m_previous;
+		m_size = index;
+		if (m_tail != nullptr) m_tail->m_next = nullptr;
+		else m_head = nullptr;
+		cut->m_previous = nullptr;
+		return tail;
+	}
+
+	// Merge the sorted list other into this sorted list O(n + m),
+	// leaving other empty
+	void merge(Linked_List& other) {
+		if (&other == this or other.isEmpty()) return;
+		if (isEmpty()) return splice(end(), other);
+		m_head = _merge(m_head, other.m_head);
+		m_head->m_previous = nullptr;
+		m_size += other.m_size;
+		other._release();
 	}
 
 	int remove_duplicate() {
@@ -300,6 +481,7 @@ public:
 	}
 
 	void sort() {
+		if (isEmpty()) return;
 		m_head = _merge_sort(m_head);
 		m_head->m_previous = nullptr;
 	}
@@ -308,7 +490,7 @@ public:
 		Node* next;
 		while (m_head != nullptr) {
 			next = m_head->m_next;
-			delete m_head;
+			_delete_node(m_head);
 			m_head = next;
 		}
 		m_tail = nullptr;
@@ -316,7 +498,7 @@ public:
 	}
 
 	T* to_array() const {
-		int* arr = new T[m_size];
+		T* arr = new T[m_size];
 		Node* temp = m_head;
 		size_t i = 0;
 		while (temp != nullptr) {
@@ -326,6 +508,33 @@ public:
 		return arr;
 	}
 
+	// Bulk export: move every element to the back of out (std::vector or
+	// our Vector) and leave this list empty
+	template<typename Vector>
+	void drain_into(Vector& out) {
+		out.reserve(out.size() + m_size);
+		for (Node* temp = m_head; temp != nullptr; temp = temp->m_next)
+			out.emplace_back(std::move(temp->m_data));
+		clear();
+	}
+
+	// Hand the elements to visit(T** items, size_t count) in batches of up to
+	// chunk_size, so the visitor can process a run without chasing pointers
+	template<typename Visitor>
+	void for_each_chunk(size_t chunk_size, Visitor visit) {
+		if (chunk_size == 0) throw std::invalid_argument("Invalid Argument");
+		std::vector<T*> chunk;
+		chunk.reserve(std::min(chunk_size, m_size));
+		for (Node* temp = m_head; temp != nullptr; temp = temp->m_next) {
+			chunk.push_back(&temp->m_data);
+			if (chunk.size() == chunk_size) {
+				visit(chunk.data(), chunk.size());
+				chunk.clear();
+			}
+		}
+		if (!chunk.empty()) visit(chunk.data(), chunk.size());
+	}
+
 	Iterator begin() {
 		return Iterator(m_head);
 	}
@@ -360,6 +569,133 @@ public:
 	}
 };
 
+// Least-recently-used cache
+// The recency order is kept in a Linked_List (most recent at the front) and
+// a hash index maps every key to its node, so a hit is an O(1) relink to the
+// front and an eviction is an O(1) unlink of the tail.
+template<typename K, typename V>
+class LRUCache {
+private:
+	class Entry {
+	public:
+		K key;
+		V value;
+		size_t bytes;
+		Entry(const K& key, const V& value, size_t bytes)
+			: key(key), value(value), bytes(bytes)
+		{}
+	};
+	using Node = typename Linked_List<Entry>::Node;
+
+	Linked_List<Entry> m_recency;
+	std::unordered_map<K, Node*> m_index;
+
+	// A limit of 0 means unbounded
+	size_t m_max_entries, m_max_bytes, m_bytes;
+	size_t m_hits, m_misses, m_evictions;
+
+	void _erase(Node* node) {
+		m_bytes -= node->m_data.bytes;
+		m_index.erase(node->m_data.key);
+		m_recency._unlink(node);
+		m_recency._delete_node(node);
+	}
+
+	void _evict() {
+		while (m_recency.m_tail != nullptr and
+		        ((m_max_entries and m_recency.m_size > m_max_entries) or
+		         (m_max_bytes and m_bytes > m_max_bytes))) {
+			_erase(m_recency.m_tail);
+			m_evictions++;
+		}
+	}
+
+public:
+	LRUCache(size_t max_entries, size_t max_bytes = 0)
+		: m_max_entries(max_entries), m_max_bytes(max_bytes), m_bytes(0),
+		  m_hits(0), m_misses(0), m_evictions(0) {
+		if (max_entries == 0 and max_bytes == 0)
+			throw std::invalid_argument("Cache needs an entry or a byte limit");
+	}
+
+	// Returns nullptr on a miss, a hit becomes the most recently used entry
+	V* get(const K& key) {
+		auto found = m_index.find(key);
+		if (found == m_index.end()) {
+			m_misses++;
+			return nullptr;
+		}
+		m_hits++;
+		m_recency._move_to_front(found->second);
+		return &found->second->m_data.value;
+	}
+
+	// Insert or overwrite key, charging bytes against the byte limit.
+	// Least recently used entries are evicted until both limits hold.
+	void put(const K& key, const V& value, size_t bytes = 0) {
+		if (m_max_bytes and bytes > m_max_bytes)
+			throw std::invalid_argument("Entry is larger than the cache");
+		auto found = m_index.find(key);
+		if (found != m_index.end()) {
+			Node* node = found->second;
+			m_bytes = m_bytes - node->m_data.bytes + bytes;
+			node->m_data.value = value;
+			node->m_data.bytes = bytes;
+			m_recency._move_to_front(node);
+		}	else	{
+			m_recency.push_front(Entry(key, value, bytes));
+			m_index[key] = m_recency.m_head;
+			m_bytes += bytes;
+		}
+		_evict();
+	}
+
+	bool remove(const K& key) {
+		auto found = m_index.find(key);
+		if (found == m_index.end()) return false;
+		_erase(found->second);
+		return true;
+	}
+
+	bool contains(const K& key) const {
+		return m_index.count(key) != 0;
+	}
+
+	void clear() {
+		m_recency.clear();
+		m_index.clear();
+		m_bytes = 0;
+	}
+
+	size_t size() const {return m_recency.m_size;}
+	size_t bytes() const {return m_bytes;}
+	size_t hits() const {return m_hits;}
+	size_t misses() const {return m_misses;}
+	size_t evictions() const {return m_evictions;}
+
+	double hit_rate() const {
+		size_t lookups = m_hits + m_misses;
+		return lookups == 0 ? 0.0 : m_hits / (double) lookups;
+	}
+
+	// Keys from most to least recently used
+	std::string to_string() const {
+		std::stringstream out;
+		out << "{ ";
+		for (Node* temp = m_recency.m_head; temp != nullptr; temp = temp->m_next) {
+			out << temp->m_data.key << ':' << temp->m_data.value;
+			if (temp->m_next != nullptr) out << " <----> ";
+		}
+		out << " }";
+		return out.str();
+	}
+
+	friend std::ostream& operator <<(std::ostream& out, const LRUCache& other) {
+		out << other.to_string();
+		return out;
+	}
+};
+
 int main() {
 	Linked_List<int> intList;
 	intList.push_back(69);
@@ -408,4 +744,58 @@ int main() {
 	std::cout << "Hello\n";
 	for (auto x : strList)
 		std::cout << x << '\n';
-}
\ No newline at end of file
+
+	std::cout << "\n=========================\n";
+
+	Linked_List<int> odds, evens;
+	for (int i = 1; i < 10; i += 2) odds.push_back(i);
+	for (int i = 0; i < 10; i += 2) evens.push_back(i);
+	odds.merge(evens);
+	std::cout << odds << '\n';
+	Linked_List<int> upper = odds.split_at(5);
+	std::cout << odds << ' ' << upper << '\n';
+	upper.splice(2, intList);
+	std::cout << upper << '\n';
+	odds.append_list(std::move(upper));
+	std::cout << odds << '\n';
+	std::cout << odds.peak_first() << ' ' << odds.peak_last() << '\n';
+
+	std::cout << "\n=========================\n";
+
+	LRUCache<std::string, int> cache(3);
+	cache.put("naruto", 1);
+	cache.put("sasuke", 2);
+	cache.put("sakura", 3);
+	std::cout << cache << '\n';
+	cache.get("naruto");
+	cache.put("kakashi", 4); // evicts sasuke
+	std::cout << cache << '\n';
+	std::cout << (cache.get("sasuke") == nullptr) << ' ' << *cache.get("sakura") << '\n';
+	std::cout << "hit rate: " << cache.hit_rate() << " evictions: " << cache.evictions() << '\n';
+
+	LRUCache<int, std::string> blobs(0, 10); // byte limited
+	blobs.put(1, "aaaa", 4);
+	blobs.put(2, "bbbb", 4);
+	blobs.put(3, "cccc", 4); // evicts 1
+	std::cout << blobs << " bytes: " << blobs.bytes() << '\n';
+	blobs.remove(2);
+	blobs.remove(3);
+	std::cout << blobs << " size: " << blobs.size() << '\n';
+
+	std::cout << "\n=========================\n";
+
+	std::vector<std::string> names = {"Itachi", "Shisui", "Kakashi", "Minato"};
+	Linked_List<std::string> bulk(names.begin(), names.end());
+	Linked_List<std::string> more = {"Gojo", "Todo"};
+	bulk.append_list(std::move(more));
+	bulk.pop_front();
+	bulk.push_back("Naruto");
+	std::cout << bulk << '\n';
+	bulk.for_each_chunk(2, [](std::string** items, size_t count) {
+		for (size_t i = 0; i < count; i++) std::cout << *items[i] << (i + 1 < count ? ", " : " | ");
+	});
+	std::cout << '\n';
+	std::vector<std::string> exported;
+	bulk.drain_into(exported);
+	std::cout << exported.size() << ' ' << exported.front() << ' ' << bulk.isEmpty() << '\n';
+}
@@ -0,0 +1,272 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Intrusive doubly-linked-list
+// The list never allocates: every object that wants to be chained embeds a
+// List_Hook and the list links the hooks directly. Linking and unlinking
+// are O(1) and an object can be removed without searching for it.
+class List_Hook {
+	List_Hook *m_next, *m_previous;
+	// The list the hook is linked into, so a list can refuse to unlink an
+	// object that belongs to another list
+	const void* m_list;
+	template<typename T, List_Hook T::*HOOK>
+	friend class Intrusive_List;
+public:
+	List_Hook()
+		: m_next(nullptr), m_previous(nullptr), m_list(nullptr)
+	{}
+
+	// A hook belongs to exactly one object, copying the object must not copy
+	// its position in a list
+	List_Hook(const List_Hook&)
+		: m_next(nullptr), m_previous(nullptr), m_list(nullptr)
+	{}
+
+	List_Hook& operator=(const List_Hook&) {
+		return *this;
+	}
+
+	bool is_linked() const {
+		return m_next != nullptr;
+	}
+};
+
+template<typename T, List_Hook T::*HOOK>
+class Intrusive_List {
+private:
+	class Iterator {
+	private:
+		List_Hook* m_ptr;
+		friend class Intrusive_List;
+	public:
+		Iterator(List_Hook* ptr)
+			: m_ptr(ptr)
+		{}
+		Iterator operator++() {
+			m_ptr = m_ptr->m_next;
+			return *this;
+		}
+		Iterator operator++(int) {
+			Iterator temp = *this;
+			m_ptr = m_ptr->m_next;
+			return temp;
+		}
+		Iterator operator--() {
+			m_ptr = m_ptr->m_previous;
+			return *this;
+		}
+		Iterator operator--(int) {
+			Iterator temp = *this;
+			m_ptr = m_ptr->m_previous;
+			return temp;
+		}
+		T* operator->() const {
+			return _owner(m_ptr);
+		}
+		T& operator*() const {
+			return *_owner(m_ptr);
+		}
+		bool operator==(const Iterator& other) const {
+			return m_ptr == other.m_ptr;
+		}
+		bool operator!=(const Iterator& other) const {
+			return m_ptr != other.m_ptr;
+		}
+	};
+
+private:
+	size_t m_size;
+	// Sentinel of the circular chain, m_root.m_next is the head and
+	// m_root.m_previous is the tail. It removes every nullptr check from
+	// link and unlink.
+	List_Hook m_root;
+
+	// Recover the object from the address of its embedded hook
+	static T* _owner(List_Hook* hook) {
+		return reinterpret_cast<T*>(reinterpret_cast<char*>(hook) - _offset());
+	}
+
+	static size_t _offset() {
+		alignas(T) static char probe[sizeof(T)];
+		T* object = reinterpret_cast<T*>(probe);
+		return reinterpret_cast<char*>(&(object->*HOOK)) - probe;
+	}
+
+	void _link_before(List_Hook* position, List_Hook* hook) {
+		if (hook->is_linked()) throw std::invalid_argument("Object already linked in a list");
+		hook->m_next = position;
+		hook->m_previous = position->m_previous;
+		hook->m_list = this;
+		position->m_previous->m_next = hook;
+		position->m_previous = hook;
+		m_size++;
+	}
+
+	T& _unlink(List_Hook* hook) { //Unlink an arbritary hook from the linked list O(1)
+		hook->m_previous->m_next = hook->m_next;
+		hook->m_next->m_previous = hook->m_previous;
+		hook->m_next = hook->m_previous = nullptr;
+		hook->m_list = nullptr;
+		m_size--;
+		return *_owner(hook);
+	}
+
+public:
+	Intrusive_List()
+		: m_size(0) {
+		m_root.m_next = m_root.m_previous = &m_root;
+	}
+
+	// The sentinel is addressed by the hooks, so the list cannot be moved
+	Intrusive_List(const Intrusive_List&) = delete;
+	Intrusive_List& operator=(const Intrusive_List&) = delete;
+
+	bool isEmpty() const {
+		return m_size == 0;
+	}
+
+	size_t size() const {
+		return m_size;
+	}
+
+	void push_back(T& object) {
+		_link_before(&m_root, &(object.*HOOK));
+	}
+
+	void push_front(T& object) {
+		_link_before(m_root.m_next, &(object.*HOOK));
+	}
+
+	// Link object in front of position
+	void insert(Iterator position, T& object) {
+		_link_before(position.m_ptr, &(object.*HOOK));
+	}
+
+	T& pop_back() {
+		if (isEmpty()) throw std::runtime_error("Empty List");
+		return _unlink(m_root.m_previous);
+	}
+
+	T& pop_front() {
+		if (isEmpty()) throw std::runtime_error("Empty List");
+		return _unlink(m_root.m_next);
+	}
+
+	// Unlink object from this list O(1), the object itself is left untouched
+	void remove(T& object) {
+		if (!(object.*HOOK).is_linked()) throw std::invalid_argument("Object is not linked");
+		if ((object.*HOOK).m_list != this) throw std::invalid_argument("Object is linked in another list");
+		_unlink(&(object.*HOOK));
+	}
+
+	T& peak_first() const {
+		if (isEmpty()) throw std::runtime_error("Empty List");
+		return *_owner(m_root.m_next);
+	}
+
+	T& peak_last() const {
+		if (isEmpty()) throw std::runtime_error("Empty List");
+		return *_owner(m_root.m_previous);
+	}
+
+	// Unlinks every object, nothing is deallocated since the list owns nothing
+	void clear() {
+		while (!isEmpty()) _unlink(m_root.m_next);
+	}
+
+	Iterator begin() {
+		return Iterator(m_root.m_next);
+	}
+
+	Iterator end() {
+		return Iterator(&m_root);
+	}
+
+	~Intrusive_List() {
+		clear();
+	}
+
+	std::string to_string() const {
+		std::stringstream out;
+		out << "{ ";
+		if (isEmpty()) out << " }";
+		else {
+			List_Hook* temp = m_root.m_next;
+			while (temp != &m_root) {
+				out << *_owner(temp);
+				temp = temp->m_next;
+				if (temp != &m_root) out << " <----> ";
+			}
+			out << " }";
+		}
+		return out.str();
+	}
+
+	friend std::ostream& operator <<(std::ostream& out, const Intrusive_List& other) {
+		out << other.to_string();
+		return out;
+	}
+};
+
+//Test Class
+class Connection {
+public:
+	int fd;
+	std::string peer;
+	List_Hook idle_hook;   // position in the idle connections list
+	List_Hook timer_hook;  // position in the timeout list
+
+	Connection(int fd, const std::string& peer)
+		: fd(fd), peer(peer)
+	{}
+
+	friend std::ostream& operator<<(std::ostream& out, const Connection& other) {
+		out << other.fd << ':' << other.peer;
+		return out;
+	}
+};
+
+int main() {
+	Connection a(3, "10.0.0.1"), b(4, "10.0.0.2"), c(5, "10.0.0.3"), d(6, "10.0.0.4");
+
+	// The same objects can live in several lists at once, one hook per list
+	Intrusive_List<Connection, &Connection::idle_hook> idle;
+	Intrusive_List<Connection, &Connection::timer_hook> timeouts;
+
+	idle.push_back(a);
+	idle.push_back(b);
+	idle.push_front(c);
+	idle.push_back(d);
+	timeouts.push_back(d);
+	timeouts.push_back(a);
+	std::cout << idle << '\n';
+	std::cout << timeouts << '\n';
+
+	// O(1) removal of an arbitrary object, no search and no free
+	idle.remove(b);
+	std::cout << idle << '\n';
+	idle.insert(++idle.begin(), b);
+	std::cout << idle << '\n';
+	idle.remove(b);
+	std::cout << b.idle_hook.is_linked() << ' ' << a.idle_hook.is_linked() << '\n';
+
+	// Removing through the wrong list leaves both lists intact
+	Intrusive_List<Connection, &Connection::idle_hook> busy;
+	try {
+		busy.remove(a);
+	}	catch (const std::invalid_argument& error)	{
+		std::cout << error.what() << ", sizes " << idle.size() << ' ' << busy.size() << '\n';
+	}
+
+	std::cout << idle.pop_front() << '\n';
+	std::cout << idle.pop_back() << '\n';
+	std::cout << idle << " size: " << idle.size() << '\n';
+
+	for (auto& connection : timeouts)
+		std::cout << connection.peer << '\n';
+
+	timeouts.clear();
+	std::cout << timeouts << '\n';
+}
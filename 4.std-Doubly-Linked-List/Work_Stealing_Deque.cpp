@@ -0,0 +1,495 @@
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <type_traits>
+
+// Timer Class for benchmarking
+class Timer {
+	std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+	long long elapsed_time;
+	const char* str;
+public:
+	Timer(const char* _str = ""): str(_str) {
+		start = std::chrono::high_resolution_clock::now();
+
+	}
+	~Timer() {
+		end = std::chrono::high_resolution_clock::now();
+		elapsed_time = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+		std::cout << str << " Elapsed Time: " << elapsed_time << "ms\n";
+	}
+
+};
+
+// Chase-Lev work-stealing deque (Le, Pop, Cohen, Zappa Nardelli, PPoPP'13)
+// It is the concurrent counterpart of the Linked_List deque interface:
+// the owning thread works like a stack on the back (push_back / pop_back)
+// while any other thread may steal from the front (the pop_front end).
+// Elements live in a growable power-of-two ring buffer instead of nodes,
+// T has to be trivially copyable (tasks are passed around as pointers).
+template<typename T>
+class Work_Stealing_Deque {
+	static_assert(std::is_trivially_copyable<T>::value, "Work_Stealing_Deque needs a trivially copyable T");
+private:
+	class Ring {
+		size_t m_mask;
+		std::atomic<T>* m_buffer;
+		friend class Work_Stealing_Deque<T>;
+	public:
+		Ring(size_t capacity)
+			: m_mask(capacity - 1), m_buffer(new std::atomic<T>[capacity])
+		{}
+		~Ring() {
+			delete[] m_buffer;
+		}
+		size_t capacity() const {
+			return m_mask + 1;
+		}
+		T get(int64_t index) const {
+			return m_buffer[index & m_mask].load(std::memory_order_relaxed);
+		}
+		void put(int64_t index, T ELEMENT) {
+			m_buffer[index & m_mask].store(ELEMENT, std::memory_order_relaxed);
+		}
+		// Copy the live window [top, bottom) into a ring twice as large
+		Ring* grow(int64_t top, int64_t bottom) const {
+			Ring* bigger = new Ring(2 * capacity());
+			for (int64_t i = top; i < bottom; i++)
+				bigger->put(i, get(i));
+			return bigger;
+		}
+	};
+
+	// top and bottom are written by different threads, keep them on
+	// separate cache lines
+	alignas(64) std::atomic<int64_t> m_top;
+	alignas(64) std::atomic<int64_t> m_bottom;
+	alignas(64) std::atomic<Ring*> m_ring;
+	// A thief may still be reading an old ring after a grow, so replaced
+	// rings are only freed with the deque
+	std::vector<Ring*> m_retired;
+
+public:
+	Work_Stealing_Deque(size_t capacity = 64)
+		: m_top(0), m_bottom(0) {
+		size_t rounded = 1;
+		while (rounded < capacity) rounded *= 2;
+		m_ring.store(new Ring(rounded), std::memory_order_relaxed);
+	}
+
+	Work_Stealing_Deque(const Work_Stealing_Deque&) = delete;
+	Work_Stealing_Deque& operator=(const Work_Stealing_Deque&) = delete;
+
+	~Work_Stealing_Deque() {
+		delete m_ring.load();
+		for (Ring* ring : m_retired) delete ring;
+	}
+
+	bool isEmpty() const {
+		return size() == 0;
+	}
+
+	// Only a snapshot when other threads are stealing
+	size_t size() const {
+		int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+		int64_t top = m_top.load(std::memory_order_relaxed);
+		return bottom > top ? bottom - top : 0;
+	}
+
+	// Owner only
+	void push_back(T ELEMENT) {
+		int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+		int64_t top = m_top.load(std::memory_order_acquire);
+		Ring* ring = m_ring.load(std::memory_order_relaxed);
+		if (bottom - top > (int64_t) ring->capacity() - 1) {
+			m_retired.push_back(ring);
+			ring = ring->grow(top, bottom);
+			m_ring.store(ring, std::memory_order_release);
+		}
+		ring->put(bottom, ELEMENT);
+		std::atomic_thread_fence(std::memory_order_release);
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+	}
+
+	// Owner only, returns false when the deque is empty (or the last
+	// element was lost to a thief)
+	bool pop_back(T& ELEMENT) {
+		int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+		Ring* ring = m_ring.load(std::memory_order_relaxed);
+		m_bottom.store(bottom, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t top = m_top.load(std::memory_order_relaxed);
+
+		if (top > bottom) {
+			// Empty deque
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			return false;
+		}
+		ELEMENT = ring->get(bottom);
+		if (top == bottom) {
+			// Single element left, race the thieves for it
+			bool won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			return won;
+		}
+		return true;
+	}
+
+	// Any thread, takes the oldest element. Returns false when the deque is
+	// empty or another thread won the race.
+	bool steal(T& ELEMENT) {
+		int64_t top = m_top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t bottom = m_bottom.load(std::memory_order_acquire);
+		if (top >= bottom) return false;
+
+		Ring* ring = m_ring.load(std::memory_order_acquire);
+		ELEMENT = ring->get(top);
+		return m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+	}
+};
+
+// Fork-join thread pool on top of one Work_Stealing_Deque per worker
+// Tasks spawned by a worker go to the back of its own deque, idle workers
+// steal from the front of a random victim. Tasks spawned from outside the
+// pool go through a locked injection queue.
+class Thread_Pool {
+private:
+	class Task_Group;
+
+	class Task {
+	public:
+		std::function<void()> work;
+		Task_Group* group;
+		Task(std::function<void()> work, Task_Group* group)
+			: work(std::move(work)), group(group)
+		{}
+	};
+
+	class Task_Group {
+	public:
+		std::atomic<size_t> pending;
+		Task_Group(): pending(0) {}
+	};
+
+	std::vector<Work_Stealing_Deque<Task*>*> m_deques;
+	std::vector<std::thread> m_workers;
+	std::deque<Task*> m_injected;
+	std::mutex m_injected_lock;
+	std::atomic<bool> m_stop;
+
+	static thread_local int t_worker;
+	static thread_local Thread_Pool* t_pool;
+
+	void _run(Task* task) {
+		task->work();
+		task->group->pending.fetch_sub(1, std::memory_order_acq_rel);
+		delete task;
+	}
+
+	// Own deque first, then the injection queue, then a random victim
+	bool _find_task(Task*& task, std::minstd_rand& random) {
+		if (t_pool == this and t_worker >= 0 and m_deques[t_worker]->pop_back(task))
+			return true;
+		{
+			std::lock_guard<std::mutex> guard(m_injected_lock);
+			if (!m_injected.empty()) {
+				task = m_injected.front();
+				m_injected.pop_front();
+				return true;
+			}
+		}
+		size_t victim = random() % m_deques.size();
+		for (size_t i = 0; i < m_deques.size(); i++) {
+			if (m_deques[(victim + i) % m_deques.size()]->steal(task))
+				return true;
+		}
+		return false;
+	}
+
+	void _worker_loop(int index) {
+		t_worker = index;
+		t_pool = this;
+		std::minstd_rand random(index + 1);
+		Task* task;
+		size_t idle = 0;
+		while (!m_stop.load(std::memory_order_relaxed)) {
+			if (_find_task(task, random)) {
+				_run(task);
+				idle = 0;
+			}	else if (++idle < 64)	{
+				std::this_thread::yield();
+			}	else	{
+				std::this_thread::sleep_for(std::chrono::microseconds(50));
+			}
+		}
+	}
+
+public:
+	// A handle the caller forks tasks into and then joins on
+	class Group {
+		Thread_Pool& m_pool;
+		Task_Group m_group;
+	public:
+		Group(Thread_Pool& pool)
+			: m_pool(pool)
+		{}
+
+		void run(std::function<void()> work) {
+			m_group.pending.fetch_add(1, std::memory_order_relaxed);
+			m_pool._spawn(new Task(std::move(work), &m_group));
+		}
+
+		// Join: instead of blocking, the waiting thread runs other tasks
+		void wait() {
+			std::minstd_rand random(std::hash<std::thread::id>()(std::this_thread::get_id()));
+			Task* task;
+			while (m_group.pending.load(std::memory_order_acquire) != 0) {
+				if (m_pool._find_task(task, random)) m_pool._run(task);
+				else std::this_thread::yield();
+			}
+		}
+
+		~Group() {
+			wait();
+		}
+	};
+
+	Thread_Pool(size_t threads = std::thread::hardware_concurrency())
+		: m_stop(false) {
+		if (threads == 0) threads = 1;
+		for (size_t i = 0; i < threads; i++)
+			m_deques.push_back(new Work_Stealing_Deque<Task*>());
+		for (size_t i = 0; i < threads; i++)
+			m_workers.emplace_back(&Thread_Pool::_worker_loop, this, (int) i);
+	}
+
+	Thread_Pool(const Thread_Pool&) = delete;
+	Thread_Pool& operator=(const Thread_Pool&) = delete;
+
+	size_t size() const {
+		return m_workers.size();
+	}
+
+	~Thread_Pool() {
+		m_stop.store(true);
+		for (std::thread& worker : m_workers) worker.join();
+		for (Work_Stealing_Deque<Task*>* deque : m_deques) delete deque;
+	}
+
+private:
+	void _spawn(Task* task) {
+		if (t_pool == this and t_worker >= 0) {
+			m_deques[t_worker]->push_back(task);
+		}	else	{
+			std::lock_guard<std::mutex> guard(m_injected_lock);
+			m_injected.push_back(task);
+		}
+	}
+};
+
+thread_local int Thread_Pool::t_worker = -1;
+thread_local Thread_Pool* Thread_Pool::t_pool = nullptr;
+
+// ===================== Fork-join workloads =====================
+
+// Linked list merge sort (the same _split / _merge scheme as Linked_List)
+class Node {
+public:
+	int data;
+	Node* next;
+};
+
+Node* _split(Node* head) {
+	Node *fast = head, *slow = head;
+	while (fast->next != nullptr and fast->next->next != nullptr) {
+		slow = slow->next;
+		fast = fast->next->next;
+	}
+	fast = slow->next;
+	slow->next = nullptr;
+	return fast;
+}
+
+Node* _merge(Node* first, Node* second) {
+	Node dummy;
+	Node* last = &dummy;
+	while (first != nullptr and second != nullptr) {
+		Node*& smaller = second->data < first->data ? second : first;
+		last->next = smaller;
+		last = smaller;
+		smaller = smaller->next;
+	}
+	last->next = first != nullptr ? first : second;
+	return dummy.next;
+}
+
+Node* merge_sort(Node* head) {
+	if (head == nullptr or head->next == nullptr) return head;
+	Node* second = _split(head);
+	head = merge_sort(head);
+	second = merge_sort(second);
+	return _merge(head, second);
+}
+
+// Sort both halves as parallel tasks until the list is short
+Node* parallel_merge_sort(Thread_Pool& pool, Node* head, size_t length) {
+	if (length < 4096) return merge_sort(head);
+	Node* second = _split(head);
+	{
+		Thread_Pool::Group group(pool);
+		group.run([&] {head = parallel_merge_sort(pool, head, (length + 1) / 2);});
+		second = parallel_merge_sort(pool, second, length / 2);
+	}
+	return _merge(head, second);
+}
+
+// Balanced BST from sorted keys, left and right subtrees built in parallel
+class TreeNode {
+public:
+	int key;
+	TreeNode *left, *right;
+	TreeNode(int key): key(key), left(nullptr), right(nullptr) {}
+};
+
+TreeNode* build_tree(const std::vector<int>& keys, size_t lo, size_t hi) {
+	if (lo >= hi) return nullptr;
+	size_t mid = lo + (hi - lo) / 2;
+	TreeNode* node = new TreeNode(keys[mid]);
+	node->left = build_tree(keys, lo, mid);
+	node->right = build_tree(keys, mid + 1, hi);
+	return node;
+}
+
+TreeNode* parallel_build_tree(Thread_Pool& pool, const std::vector<int>& keys, size_t lo, size_t hi) {
+	if (hi - lo < 4096) return build_tree(keys, lo, hi);
+	size_t mid = lo + (hi - lo) / 2;
+	TreeNode* node = new TreeNode(keys[mid]);
+	{
+		Thread_Pool::Group group(pool);
+		group.run([&] {node->left = parallel_build_tree(pool, keys, lo, mid);});
+		node->right = parallel_build_tree(pool, keys, mid + 1, hi);
+	}
+	return node;
+}
+
+size_t tree_size(TreeNode* node) {
+	size_t count = 0;
+	std::vector<TreeNode*> stack;
+	if (node) stack.push_back(node);
+	while (!stack.empty()) {
+		TreeNode* cur = stack.back();
+		stack.pop_back();
+		count++;
+		if (cur->left) stack.push_back(cur->left);
+		if (cur->right) stack.push_back(cur->right);
+	}
+	return count;
+}
+
+void delete_tree(TreeNode* node) {
+	std::vector<TreeNode*> stack;
+	if (node) stack.push_back(node);
+	while (!stack.empty()) {
+		TreeNode* cur = stack.back();
+		stack.pop_back();
+		if (cur->left) stack.push_back(cur->left);
+		if (cur->right) stack.push_back(cur->right);
+		delete cur;
+	}
+}
+
+Node* make_list(std::vector<Node>& nodes) {
+	std::mt19937 random(42);
+	for (size_t i = 0; i < nodes.size(); i++) {
+		nodes[i].data = random();
+		nodes[i].next = i + 1 < nodes.size() ? &nodes[i + 1] : nullptr;
+	}
+	return &nodes[0];
+}
+
+bool is_sorted(Node* head) {
+	for (; head->next != nullptr; head = head->next)
+		if (head->next->data < head->data) return false;
+	return true;
+}
+
+int main() {
+	// Single threaded sanity check of the deque: back is LIFO, front is FIFO
+	Work_Stealing_Deque<int> deque(2);
+	for (int i = 0; i < 10; i++) deque.push_back(i);
+	int x;
+	deque.steal(x);
+	std::cout << x << ' ';
+	deque.pop_back(x);
+	std::cout << x << " size: " << deque.size() << '\n';
+
+	// Concurrent check: every pushed element is taken exactly once
+	{
+		Work_Stealing_Deque<int> shared;
+		const int n = 1000000;
+		std::atomic<long long> stolen_sum(0);
+		std::atomic<bool> done(false);
+		std::vector<std::thread> thieves;
+		for (int t = 0; t < 3; t++)
+			thieves.emplace_back([&] {
+				int value;
+				long long local = 0;
+				while (!done.load() or !shared.isEmpty())
+					if (shared.steal(value)) local += value;
+				stolen_sum += local;
+			});
+		long long owner_sum = 0;
+		for (int i = 1; i <= n; i++) {
+			shared.push_back(i);
+			if (i % 3 == 0 and shared.pop_back(x)) owner_sum += x;
+		}
+		while (shared.pop_back(x)) owner_sum += x;
+		done.store(true);
+		for (std::thread& thief : thieves) thief.join();
+		std::cout << "sum ok: " << (owner_sum + stolen_sum == (long long) n * (n + 1) / 2) << '\n';
+	}
+
+	Thread_Pool pool;
+	std::cout << "\n=== fork-join benchmarks, " << pool.size() << " workers ===\n";
+
+	const size_t n = 1 << 21;
+	std::vector<Node> nodes(n);
+	Node* head = make_list(nodes);
+	{
+		Timer t("List merge sort (sequential)");
+		head = merge_sort(head);
+	}
+	std::cout << "sorted: " << is_sorted(head) << '\n';
+
+	head = make_list(nodes);
+	{
+		Timer t("List merge sort (work stealing)");
+		head = parallel_merge_sort(pool, head, n);
+	}
+	std::cout << "sorted: " << is_sorted(head) << '\n';
+
+	std::vector<int> keys(n);
+	for (size_t i = 0; i < n; i++) keys[i] = i;
+	TreeNode* root;
+	{
+		Timer t("Tree build (sequential)");
+		root = build_tree(keys, 0, n);
+	}
+	std::cout << "nodes: " << tree_size(root) << '\n';
+	delete_tree(root);
+	{
+		Timer t("Tree build (work stealing)");
+		root = parallel_build_tree(pool, keys, 0, n);
+	}
+	std::cout << "nodes: " << tree_size(root) << '\n';
+	delete_tree(root);
+	return 0;
+}
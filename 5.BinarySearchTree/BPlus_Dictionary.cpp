@@ -0,0 +1,462 @@
+#include <iostream>
+#include <utility>
+#include <string>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// How many of the first n keys are less than key.
+// Nodes are small, so a branch-free linear scan beats a binary search.
+template <typename K>
+size_t _count_less(const K* keys, size_t n, const K& key) {
+	size_t count = 0;
+	for (size_t i = 0; i < n; i++) count += keys[i] < key;
+	return count;
+}
+
+// How many of the first n keys are less than or equal to key
+template <typename K>
+size_t _count_less_equal(const K* keys, size_t n, const K& key) {
+	size_t count = 0;
+	for (size_t i = 0; i < n; i++) count += !(key < keys[i]);
+	return count;
+}
+
+#if defined(__SSE2__)
+// int keys are compared four at a time
+inline size_t _count_less(const int* keys, size_t n, const int& key) {
+	__m128i needle = _mm_set1_epi32(key);
+	size_t count = 0, i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+		count += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(block, needle))));
+	}
+	for (; i < n; i++) count += keys[i] < key;
+	return count;
+}
+
+inline size_t _count_less_equal(const int* keys, size_t n, const int& key) {
+	__m128i needle = _mm_set1_epi32(key);
+	size_t greater = 0, i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+		greater += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(block, needle))));
+	}
+	for (; i < n; i++) greater += key < keys[i];
+	return n - greater;
+}
+#endif
+
+// B+ tree with the Dictionary interface
+// Every node is NODE_BYTES large (a few cache lines by default, or a page)
+// and holds as many keys as fit, so a lookup costs one miss per level of a
+// much flatter tree than Dictionary's one-key nodes. Data lives only in the
+// leaves, which are chained left to right for range scans.
+// K and D need to be default constructible (nodes hold fixed arrays).
+template <typename K, typename D, size_t NODE_BYTES = 256>
+class BPlusDictionary {
+private:
+	static constexpr size_t _fit(size_t bytes, size_t entry) {
+		return bytes / entry < 3 ? 3 : bytes / entry;
+	}
+	static constexpr size_t INNER_KEYS = _fit(NODE_BYTES - 2 * sizeof(size_t) - sizeof(void*), sizeof(K) + sizeof(void*));
+	static constexpr size_t LEAF_KEYS = _fit(NODE_BYTES - 4 * sizeof(size_t), sizeof(K) + sizeof(D));
+	// Fewest keys a non-root node may hold
+	static constexpr size_t INNER_MIN = INNER_KEYS / 2;
+	static constexpr size_t LEAF_MIN = LEAF_KEYS / 2;
+
+	class Node {
+	public:
+		bool leaf;
+		size_t count;
+		Node(bool leaf)
+			: leaf(leaf), count(0) { }
+	};
+
+	// Child i holds the keys k with keys[i - 1] <= k < keys[i]
+	class alignas(64) Inner : public Node {
+	public:
+		K keys[INNER_KEYS];
+		Node* children[INNER_KEYS + 1];
+		Inner()
+			: Node(false) { }
+	};
+
+	class alignas(64) Leaf : public Node {
+	public:
+		K keys[LEAF_KEYS];
+		D data[LEAF_KEYS];
+		Leaf *next, *previous;
+		Leaf()
+			: Node(true), next(nullptr), previous(nullptr) { }
+	};
+
+	Node* m_root;
+	Leaf* m_first;
+	size_t m_size;
+
+	Leaf* _findLeaf(const K& key) const {
+		Node* node = m_root;
+		while (!node->leaf) {
+			Inner* inner = static_cast<Inner*>(node);
+			node = inner->children[_count_less_equal(inner->keys, inner->count, key)];
+		}
+		return static_cast<Leaf*>(node);
+	}
+
+	// Insert into the subtree at node. If node had to split, the new right
+	// sibling and the smallest key routed to it are handed back to the
+	// parent through split_key / split_node.
+	void _insert(Node* node, const K& key, const D& data, K& split_key, Node*& split_node) {
+		if (node->leaf) {
+			Leaf* leaf = static_cast<Leaf*>(node);
+			size_t i = _count_less(leaf->keys, leaf->count, key);
+			if (i < leaf->count and leaf->keys[i] == key) { throw std::runtime_error("error: insert() used on an existing key"); }
+
+			if (leaf->count < LEAF_KEYS) {
+				_leafInsertAt(leaf, i, key, data);
+				return;
+			}
+
+			// Full leaf: split so that the left half keeps (LEAF_KEYS + 1) / 2
+			Leaf* right = new Leaf();
+			size_t half = (LEAF_KEYS + 1) / 2;
+			size_t from = i < half ? half - 1 : half;
+			for (size_t j = from; j < LEAF_KEYS; j++) {
+				right->keys[j - from] = std::move(leaf->keys[j]);
+				right->data[j - from] = std::move(leaf->data[j]);
+			}
+			right->count = LEAF_KEYS - from;
+			leaf->count = from;
+			if (i < half) _leafInsertAt(leaf, i, key, data);
+			else _leafInsertAt(right, i - half, key, data);
+
+			right->next = leaf->next;
+			right->previous = leaf;
+			if (leaf->next) leaf->next->previous = right;
+			leaf->next = right;
+
+			split_key = right->keys[0];
+			split_node = right;
+			return;
+		}
+
+		Inner* inner = static_cast<Inner*>(node);
+		size_t i = _count_less_equal(inner->keys, inner->count, key);
+		K child_key;
+		Node* child_node = nullptr;
+		_insert(inner->children[i], key, data, child_key, child_node);
+		if (!child_node) return;
+
+		if (inner->count < INNER_KEYS) {
+			for (size_t j = inner->count; j > i; j--) {
+				inner->keys[j] = std::move(inner->keys[j - 1]);
+				inner->children[j + 1] = inner->children[j];
+			}
+			inner->keys[i] = child_key;
+			inner->children[i + 1] = child_node;
+			inner->count++;
+			return;
+		}
+
+		// Full inner node: lay out all INNER_KEYS + 1 keys, push the middle
+		// one up and move everything after it to a new right sibling
+		K keys[INNER_KEYS + 1];
+		Node* children[INNER_KEYS + 2];
+		for (size_t j = 0, k = 0; j <= INNER_KEYS; j++) keys[j] = j == i ? child_key : std::move(inner->keys[k++]);
+		for (size_t j = 0, k = 0; j <= INNER_KEYS + 1; j++) children[j] = j == i + 1 ? child_node : inner->children[k++];
+
+		size_t mid = (INNER_KEYS + 1) / 2;
+		Inner* right = new Inner();
+		for (size_t j = 0; j < mid; j++) {
+			inner->keys[j] = std::move(keys[j]);
+			inner->children[j] = children[j];
+		}
+		inner->children[mid] = children[mid];
+		inner->count = mid;
+		for (size_t j = mid + 1; j <= INNER_KEYS; j++) {
+			right->keys[j - mid - 1] = std::move(keys[j]);
+			right->children[j - mid - 1] = children[j];
+		}
+		right->children[INNER_KEYS - mid] = children[INNER_KEYS + 1];
+		right->count = INNER_KEYS - mid;
+
+		split_key = std::move(keys[mid]);
+		split_node = right;
+	}
+
+	void _leafInsertAt(Leaf* leaf, size_t i, const K& key, const D& data) {
+		for (size_t j = leaf->count; j > i; j--) {
+			leaf->keys[j] = std::move(leaf->keys[j - 1]);
+			leaf->data[j] = std::move(leaf->data[j - 1]);
+		}
+		leaf->keys[i] = key;
+		leaf->data[i] = data;
+		leaf->count++;
+	}
+
+	// Remove key from the subtree at node, the key is known to exist.
+	// Returns true if node is left with fewer keys than allowed.
+	bool _remove(Node* node, const K& key) {
+		if (node->leaf) {
+			Leaf* leaf = static_cast<Leaf*>(node);
+			size_t i = _count_less(leaf->keys, leaf->count, key);
+			for (size_t j = i + 1; j < leaf->count; j++) {
+				leaf->keys[j - 1] = std::move(leaf->keys[j]);
+				leaf->data[j - 1] = std::move(leaf->data[j]);
+			}
+			leaf->count--;
+			return leaf->count < LEAF_MIN;
+		}
+
+		Inner* inner = static_cast<Inner*>(node);
+		size_t i = _count_less_equal(inner->keys, inner->count, key);
+		if (_remove(inner->children[i], key)) _repair(inner, i);
+		return inner->count < INNER_MIN;
+	}
+
+	// Child i of parent is one key short: borrow from a sibling that can
+	// spare one, otherwise merge with a sibling
+	void _repair(Inner* parent, size_t i) {
+		Node* left = i > 0 ? parent->children[i - 1] : nullptr;
+		Node* right = i < parent->count ? parent->children[i + 1] : nullptr;
+		Node* child = parent->children[i];
+
+		if (child->leaf) {
+			Leaf* leaf = static_cast<Leaf*>(child);
+			if (left and left->count > LEAF_MIN) {
+				Leaf* from = static_cast<Leaf*>(left);
+				from->count--;
+				_leafInsertAt(leaf, 0, from->keys[from->count], from->data[from->count]);
+				parent->keys[i - 1] = leaf->keys[0];
+			}	else if (right and right->count > LEAF_MIN) {
+				Leaf* from = static_cast<Leaf*>(right);
+				_leafInsertAt(leaf, leaf->count, from->keys[0], from->data[0]);
+				_remove(from, from->keys[0]);
+				parent->keys[i] = from->keys[0];
+			}	else if (left) {
+				_mergeLeaves(static_cast<Leaf*>(left), leaf);
+				_dropChild(parent, i - 1);
+			}	else	{
+				_mergeLeaves(leaf, static_cast<Leaf*>(right));
+				_dropChild(parent, i);
+			}
+			return;
+		}
+
+		Inner* inner = static_cast<Inner*>(child);
+		if (left and left->count > INNER_MIN) {
+			// Rotate right through the parent separator
+			Inner* from = static_cast<Inner*>(left);
+			for (size_t j = inner->count; j > 0; j--) {
+				inner->keys[j] = std::move(inner->keys[j - 1]);
+				inner->children[j + 1] = inner->children[j];
+			}
+			inner->children[1] = inner->children[0];
+			inner->keys[0] = std::move(parent->keys[i - 1]);
+			inner->children[0] = from->children[from->count];
+			inner->count++;
+			parent->keys[i - 1] = std::move(from->keys[from->count - 1]);
+			from->count--;
+		}	else if (right and right->count > INNER_MIN) {
+			// Rotate left through the parent separator
+			Inner* from = static_cast<Inner*>(right);
+			inner->keys[inner->count] = std::move(parent->keys[i]);
+			inner->children[inner->count + 1] = from->children[0];
+			inner->count++;
+			parent->keys[i] = std::move(from->keys[0]);
+			for (size_t j = 1; j < from->count; j++) {
+				from->keys[j - 1] = std::move(from->keys[j]);
+				from->children[j - 1] = from->children[j];
+			}
+			from->children[from->count - 1] = from->children[from->count];
+			from->count--;
+		}	else if (left) {
+			_mergeInner(static_cast<Inner*>(left), inner, parent->keys[i - 1]);
+			_dropChild(parent, i - 1);
+		}	else	{
+			_mergeInner(inner, static_cast<Inner*>(right), parent->keys[i]);
+			_dropChild(parent, i);
+		}
+	}
+
+	// Append right to left and free right
+	void _mergeLeaves(Leaf* left, Leaf* right) {
+		for (size_t j = 0; j < right->count; j++) {
+			left->keys[left->count + j] = std::move(right->keys[j]);
+			left->data[left->count + j] = std::move(right->data[j]);
+		}
+		left->count += right->count;
+		left->next = right->next;
+		if (right->next) right->next->previous = left;
+		delete right;
+	}
+
+	// Append the separator and then right to left, and free right
+	void _mergeInner(Inner* left, Inner* right, const K& separator) {
+		left->keys[left->count] = separator;
+		for (size_t j = 0; j < right->count; j++) {
+			left->keys[left->count + 1 + j] = std::move(right->keys[j]);
+			left->children[left->count + 1 + j] = right->children[j];
+		}
+		left->children[left->count + 1 + right->count] = right->children[right->count];
+		left->count += 1 + right->count;
+		delete right;
+	}
+
+	// Remove separator i and child i + 1 (already merged away) from parent
+	void _dropChild(Inner* parent, size_t i) {
+		for (size_t j = i + 1; j < parent->count; j++) {
+			parent->keys[j - 1] = std::move(parent->keys[j]);
+			parent->children[j] = parent->children[j + 1];
+		}
+		parent->count--;
+	}
+
+	void _destroy(Node* node) {
+		if (node == nullptr) return;
+		if (node->leaf) {
+			delete static_cast<Leaf*>(node);
+			return;
+		}
+		Inner* inner = static_cast<Inner*>(node);
+		for (size_t i = 0; i <= inner->count; i++) _destroy(inner->children[i]);
+		delete inner;
+	}
+
+public:
+	BPlusDictionary()
+		: m_root(nullptr), m_first(nullptr), m_size(0) { }
+
+	BPlusDictionary(const BPlusDictionary&) = delete;
+	BPlusDictionary& operator=(const BPlusDictionary&) = delete;
+
+	bool empty() const {
+		return m_size == 0;
+	}
+
+	size_t size() const {
+		return m_size;
+	}
+
+	const D& find(const K& key) const {
+		if (m_root) {
+			Leaf* leaf = _findLeaf(key);
+			size_t i = _count_less(leaf->keys, leaf->count, key);
+			if (i < leaf->count and leaf->keys[i] == key) return leaf->data[i];
+		}
+		throw std::runtime_error("error: key not found");
+	}
+
+	bool contains(const K& key) const {
+		if (!m_root) return false;
+		Leaf* leaf = _findLeaf(key);
+		size_t i = _count_less(leaf->keys, leaf->count, key);
+		return i < leaf->count and leaf->keys[i] == key;
+	}
+
+	void insert(const K& key, const D& data) {
+		if (!m_root) m_root = m_first = new Leaf();
+
+		K split_key;
+		Node* split_node = nullptr;
+		_insert(m_root, key, data, split_key, split_node);
+		m_size++;
+
+		// The root split, grow the tree by one level
+		if (split_node) {
+			Inner* root = new Inner();
+			root->keys[0] = split_key;
+			root->children[0] = m_root;
+			root->children[1] = split_node;
+			root->count = 1;
+			m_root = root;
+		}
+	}
+
+	void remove(const K& key) {
+		if (!contains(key)) {
+			throw std::runtime_error("error: remove() used on non-existent key");
+		}
+		_remove(m_root, key);
+		m_size--;
+
+		// The root may have lost its last separator or its last entry
+		if (!m_root->leaf and m_root->count == 0) {
+			Inner* old = static_cast<Inner*>(m_root);
+			m_root = old->children[0];
+			delete old;
+		}	else if (m_root->leaf and m_root->count == 0) {
+			delete static_cast<Leaf*>(m_root);
+			m_root = m_first = nullptr;
+		}
+	}
+
+	// Call visit(key, data) for every key in [lo, hi] in ascending order,
+	// walking the leaf chain instead of the tree
+	template <typename Visitor>
+	void range(const K& lo, const K& hi, Visitor visit) const {
+		if (!m_root) return;
+		Leaf* leaf = _findLeaf(lo);
+		size_t i = _count_less(leaf->keys, leaf->count, lo);
+		for (; leaf; leaf = leaf->next, i = 0) {
+			for (; i < leaf->count; i++) {
+				if (hi < leaf->keys[i]) return;
+				visit(leaf->keys[i], leaf->data[i]);
+			}
+		}
+	}
+
+	void printInOrder() const {
+		for (Leaf* leaf = m_first; leaf; leaf = leaf->next)
+			for (size_t i = 0; i < leaf->count; i++)
+				std::cout << "[" << leaf->keys[i] << " : " << leaf->data[i] << "]";
+		std::cout << " ";
+	}
+
+	void clear() {
+		_destroy(m_root);
+		m_root = m_first = nullptr;
+		m_size = 0;
+	}
+
+	~BPlusDictionary() {
+		clear();
+	}
+};
+
+int main() {
+	BPlusDictionary<int, std::string> digits;
+	digits.insert(5, "five");
+	digits.insert(6, "six");
+	digits.insert(4, "four");
+	digits.insert(8, "eight");
+	digits.insert(9, "nine");
+	digits.insert(2, "two");
+	digits.insert(7, "seven");
+	digits.insert(1, "one");
+	digits.insert(3, "three");
+	digits.printInOrder();
+	digits.remove(5);
+	std::cout << '\n';
+	digits.printInOrder();
+	digits.remove(1);
+	std::cout << '\n';
+	digits.printInOrder();
+	std::cout << "\n---------------\n" << digits.find(3) << '\n';
+	digits.range(3, 7, [](const int& key, const std::string & data) {
+		std::cout << "[" << key << " : " << data << "]";
+	});
+	std::cout << '\n';
+
+	// Small nodes force a deep tree with many splits and merges
+	BPlusDictionary<int, int, 64> numbers;
+	const int n = 200000;
+	for (int i = 0; i < n; i++) numbers.insert((i * 7919) % n, i);
+	for (int i = 0; i < n; i += 2) numbers.remove(i);
+	long long sum = 0;
+	int count = 0;
+	numbers.range(0, n, [&](const int& key, const int&) {sum += key; count++;});
+	std::cout << numbers.size() << ' ' << count << ' ' << sum << ' ' << numbers.contains(2) << numbers.contains(3) << '\n';
+	return 0;
+}
@@ -0,0 +1,591 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <cstdint>
+
+// Timer Class for benchmarking
+class Timer {
+	std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+	long long elapsed_time;
+	const char* str;
+public:
+	Timer(const char* _str = ""): str(_str) {
+		start = std::chrono::high_resolution_clock::now();
+
+	}
+	~Timer() {
+		end = std::chrono::high_resolution_clock::now();
+		elapsed_time = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+		std::cout << "\n" << str << " Elapsed Time: " << elapsed_time << "ms\n";
+	}
+
+};
+
+
+// Thread-safe binary search tree with optimistic lock coupling
+// Every node carries a version word. Readers never write to it: they
+// remember the version, read the node, and check the version is
+// unchanged before trusting what they read, starting over if it moved.
+// Writers descend the same way and then lock only the few nodes they
+// change (by bumping the version), so threads working on different parts
+// of the tree do not block each other.
+//
+// Keys and data are never modified once a node is linked (removal
+// relinks the in-order predecessor instead of copying it), so concurrent
+// readers can look at them without synchronisation. Removed nodes may
+// still be visited by a reader that is about to restart, so they are
+// freed with epoch based reclamation: every operation announces the
+// global epoch it started in (in its own thread's record), a removed
+// node goes on the remover's own retired list tagged with the epoch, and
+// the epoch only moves on once every thread inside an operation has
+// announced the current one. A node retired in epoch e is unreachable to
+// everyone once the epoch reaches e + 2, and is freed then, while the
+// dictionary is in use.
+template <typename K, typename D>
+class ConcurrentDictionary {
+private:
+	class TreeNode;
+
+	// Version word layout: bit 0 obsolete (removed from the tree), bit 1
+	// write-locked, the rest a counter bumped by every write unlock
+	static const uint64_t OBSOLETE = 1, LOCKED = 2;
+
+	// The part of a node that writers lock. The tree hangs off the left
+	// link of a key-less sentinel, so the root has a parent to lock too.
+	class Link {
+	public:
+		std::atomic<uint64_t> version;
+		std::atomic<TreeNode*> left, right;
+		Link()
+			: version(0), left(nullptr), right(nullptr) { }
+	};
+
+	class TreeNode : public Link {
+	public:
+		const K key;
+		const D data;
+		TreeNode(const K& key, const D& data)
+			: key(key), data(data) { }
+	};
+
+	// Where a descent for a key ended: node holds the key (or is nullptr
+	// if the key is absent) and slot is the link in parent that points to
+	// it. Both versions were validated together.
+	struct Position {
+		Link* parent;
+		uint64_t parent_version;
+		std::atomic<TreeNode*>* slot;
+		TreeNode* node;
+		uint64_t node_version;
+	};
+
+	// One per thread using the dictionary, on its own cache line, written
+	// only by that thread except for the claim when a thread first shows up
+	class alignas(64) ThreadRecord {
+	public:
+		// Epoch announced by an operation in progress, 0 between operations
+		std::atomic<uint64_t> epoch;
+		std::atomic<bool> in_use;
+		// Removed nodes with the epoch they were retired in, oldest first
+		std::vector<std::pair<uint64_t, TreeNode*>> retired;
+		// Size of retired, readable by other threads
+		std::atomic<size_t> pending;
+		ThreadRecord* next;
+		ThreadRecord()
+			: epoch(0), in_use(true), pending(0), next(nullptr) { }
+	};
+
+	// Records are only ever added, and are shared with the threads'
+	// caches so that a thread exiting can hand its record back even while
+	// the dictionary is being destroyed
+	class Registry {
+	public:
+		std::atomic<ThreadRecord*> head;
+		Registry()
+			: head(nullptr) { }
+		~Registry() {
+			for (ThreadRecord* record = head.load(); record;) {
+				ThreadRecord* next = record->next;
+				for (auto& entry : record->retired) delete entry.second;
+				delete record;
+				record = next;
+			}
+		}
+	};
+
+	// A thread's records, one per dictionary it has used. Records go back
+	// to their dictionary (pending nodes and all, for the next thread that
+	// claims it) when the thread exits.
+	class ThreadCache {
+	public:
+		struct Entry {
+			uint64_t id;
+			std::weak_ptr<Registry> registry;
+			ThreadRecord* record;
+		};
+		std::vector<Entry> entries;
+		~ThreadCache() {
+			for (Entry& entry : entries)
+				if (std::shared_ptr<Registry> alive = entry.registry.lock())
+					entry.record->in_use.store(false, std::memory_order_release);
+		}
+	};
+
+	// Announces the epoch for the length of one operation
+	class EpochGuard {
+		ThreadRecord* m_record;
+	public:
+		EpochGuard(ConcurrentDictionary& dictionary)
+			: m_record(dictionary._record()) {
+			// Re-check after announcing, an epoch that moved on in between
+			// could otherwise be announced too late to hold anything back
+			uint64_t epoch;
+			do {
+				epoch = dictionary.m_epoch.load();
+				m_record->epoch.store(epoch);
+			} while (dictionary.m_epoch.load() != epoch);
+		}
+		~EpochGuard() {
+			m_record->epoch.store(0, std::memory_order_release);
+		}
+		ThreadRecord* record() const {
+			return m_record;
+		}
+	};
+
+	// Retired nodes a thread collects before it tries to advance the epoch
+	// and free what it can
+	static const size_t RETIRE_BATCH = 64;
+
+	Link m_sentinel;
+	std::atomic<size_t> m_size;
+	std::atomic<uint64_t> m_epoch;
+	std::shared_ptr<Registry> m_registry;
+	// Tells the dictionaries in a thread's cache apart (addresses get reused)
+	const uint64_t m_id;
+
+	static uint64_t _nextId() {
+		static std::atomic<uint64_t> counter(0);
+		return ++counter;
+	}
+
+	// This thread's record, claimed (an abandoned one if there is one) or
+	// added on first use
+	ThreadRecord* _record() {
+		static thread_local ThreadCache cache;
+		for (auto& entry : cache.entries)
+			if (entry.id == m_id) return entry.record;
+
+		// Forget dictionaries that are gone
+		for (size_t i = cache.entries.size(); i-- > 0;) {
+			if (cache.entries[i].registry.expired()) {
+				cache.entries[i] = cache.entries.back();
+				cache.entries.pop_back();
+			}
+		}
+		ThreadRecord* record = nullptr;
+		for (ThreadRecord* cur = m_registry->head.load(std::memory_order_acquire); cur and !record; cur = cur->next) {
+			bool free = false;
+			if (cur->in_use.compare_exchange_strong(free, true, std::memory_order_acquire)) record = cur;
+		}
+		if (record == nullptr) {
+			record = new ThreadRecord();
+			ThreadRecord* head = m_registry->head.load(std::memory_order_relaxed);
+			do {
+				record->next = head;
+			} while (!m_registry->head.compare_exchange_weak(head, record, std::memory_order_release, std::memory_order_relaxed));
+		}
+		cache.entries.push_back({m_id, m_registry, record});
+		return record;
+	}
+
+	// Move the epoch on if every thread inside an operation has seen the
+	// current one
+	void _tryAdvance() {
+		uint64_t epoch = m_epoch.load();
+		for (ThreadRecord* cur = m_registry->head.load(std::memory_order_acquire); cur; cur = cur->next) {
+			uint64_t announced = cur->epoch.load();
+			if (announced != 0 and announced != epoch) return;
+		}
+		m_epoch.compare_exchange_strong(epoch, epoch + 1);
+	}
+
+	// Free the caller's retired nodes that no thread can still reach
+	void _collect(ThreadRecord* record) {
+		uint64_t epoch = m_epoch.load();
+		size_t freed = 0;
+		while (freed < record->retired.size() and record->retired[freed].first + 2 <= epoch)
+			delete record->retired[freed++].second;
+		record->retired.erase(record->retired.begin(), record->retired.begin() + freed);
+		record->pending.store(record->retired.size(), std::memory_order_relaxed);
+	}
+
+	static bool _readLock(const Link* link, uint64_t& version) {
+		version = link->version.load(std::memory_order_acquire);
+		return (version & (LOCKED | OBSOLETE)) == 0;
+	}
+
+	// Nothing read since version was taken can be stale if it still holds
+	static bool _validate(const Link* link, uint64_t version) {
+		std::atomic_thread_fence(std::memory_order_acquire);
+		return link->version.load(std::memory_order_relaxed) == version;
+	}
+
+	static bool _upgrade(Link* link, uint64_t version) {
+		return link->version.compare_exchange_strong(version, version + LOCKED, std::memory_order_acquire);
+	}
+
+	// Publish the changes made under the lock, readers that saw the old
+	// version will restart
+	static void _writeUnlock(Link* link) {
+		link->version.fetch_add(LOCKED, std::memory_order_release);
+	}
+
+	static void _writeUnlockObsolete(Link* link) {
+		link->version.fetch_add(LOCKED + OBSOLETE, std::memory_order_release);
+	}
+
+	// Give back a lock without having changed anything, so that readers
+	// holding the old version do not have to restart
+	static void _abortLock(Link* link) {
+		link->version.fetch_sub(LOCKED, std::memory_order_release);
+	}
+
+	std::atomic<TreeNode*>& _child(Link* link, const K& key) {
+		if (link == &m_sentinel or key < static_cast<TreeNode*>(link)->key) return link->left;
+		return link->right;
+	}
+
+	// Optimistic descent with lock coupling: a node's version is taken
+	// before its parent's is re-checked, so every step was a real
+	// parent-child pair at some instant. Returns false if it has to restart.
+	bool _descend(const K& key, Position& at) {
+		at.parent = &m_sentinel;
+		if (!_readLock(at.parent, at.parent_version)) return false;
+		while (true) {
+			at.slot = &_child(at.parent, key);
+			at.node = at.slot->load(std::memory_order_acquire);
+			if (at.node and !_readLock(at.node, at.node_version)) return false;
+			if (!_validate(at.parent, at.parent_version)) return false;
+			if (at.node == nullptr or key == at.node->key) return true;
+			at.parent = at.node;
+			at.parent_version = at.node_version;
+		}
+	}
+
+	// Called after node is unlinked, on the caller's own list so removes
+	// in different parts of the tree never meet here
+	void _retire(ThreadRecord* record, TreeNode* node) {
+		record->retired.push_back({m_epoch.load(), node});
+		if (record->retired.size() % RETIRE_BATCH == 0) {
+			_tryAdvance();
+			_collect(record);
+		}	else	{
+			record->pending.store(record->retired.size(), std::memory_order_relaxed);
+		}
+	}
+
+	// Unlink node, whose parent (slot holder) and node itself are locked by
+	// the caller. Returns false, with nothing changed and every lock given
+	// back, if the in-order predecessor could not be locked.
+	bool _unlink(Position& at) {
+		TreeNode* node = at.node;
+		TreeNode* left = node->left.load(std::memory_order_relaxed);
+		TreeNode* right = node->right.load(std::memory_order_relaxed);
+		if (left == nullptr or right == nullptr) {
+			at.slot->store(left ? left : right, std::memory_order_release);
+			return true;
+		}
+
+		// Two children: find the IOP (in-order predecessor) and the node
+		// above it. Both are read optimistically and then locked at the
+		// versions seen, which proves they are still in place.
+		Link* above = node;
+		TreeNode* iop = left;
+		uint64_t above_version = 0, iop_version;
+		if (!_readLock(iop, iop_version)) return false;
+		while (TreeNode* next = iop->right.load(std::memory_order_acquire)) {
+			uint64_t next_version;
+			if (!_readLock(next, next_version) or !_validate(iop, iop_version)) return false;
+			above = iop;
+			above_version = iop_version;
+			iop = next;
+			iop_version = next_version;
+		}
+		if (above != node and !_upgrade(above, above_version)) return false;
+		if (!_upgrade(iop, iop_version)) {
+			if (above != node) _abortLock(above);
+			return false;
+		}
+
+		// The IOP has no right child, so its left subtree takes its place,
+		// then it takes over the removed node's links
+		if (above != node) {
+			above->right.store(iop->left.load(std::memory_order_relaxed), std::memory_order_release);
+			iop->left.store(left, std::memory_order_release);
+			_writeUnlock(above);
+		}
+		iop->right.store(right, std::memory_order_release);
+		at.slot->store(iop, std::memory_order_release);
+		_writeUnlock(iop);
+		return true;
+	}
+
+	static void _destroy(TreeNode* node) {
+		std::vector<TreeNode*> stack;
+		if (node) stack.push_back(node);
+		while (!stack.empty()) {
+			node = stack.back();
+			stack.pop_back();
+			if (TreeNode* left = node->left.load(std::memory_order_relaxed)) stack.push_back(left);
+			if (TreeNode* right = node->right.load(std::memory_order_relaxed)) stack.push_back(right);
+			delete node;
+		}
+	}
+
+public:
+	ConcurrentDictionary()
+		: m_size(0), m_epoch(1), m_registry(std::make_shared<Registry>()), m_id(_nextId()) { }
+
+	ConcurrentDictionary(const ConcurrentDictionary&) = delete;
+	ConcurrentDictionary& operator=(const ConcurrentDictionary&) = delete;
+
+	// Approximate while writers are active
+	size_t size() const {
+		return m_size.load(std::memory_order_relaxed);
+	}
+
+	bool empty() const {
+		return size() == 0;
+	}
+
+	// Returns a copy, since the entry may be removed as soon as this returns
+	D find(const K& key) {
+		EpochGuard guard(*this);
+		Position at;
+		while (!_descend(key, at)) { }
+		if (at.node == nullptr) { throw std::runtime_error("error: key not found"); }
+		return at.node->data;
+	}
+
+	bool contains(const K& key) {
+		EpochGuard guard(*this);
+		Position at;
+		while (!_descend(key, at)) { }
+		return at.node != nullptr;
+	}
+
+	void insert(const K& key, const D& data) {
+		EpochGuard guard(*this);
+		TreeNode* node = nullptr;
+		while (true) {
+			Position at;
+			if (!_descend(key, at)) continue;
+			if (at.node) {
+				delete node;
+				throw std::runtime_error("error: insert() used on an existing key");
+			}
+			// Build the node before locking so the lock is held for as
+			// short as possible
+			if (node == nullptr) node = new TreeNode(key, data);
+			if (!_upgrade(at.parent, at.parent_version)) continue;
+			at.slot->store(node, std::memory_order_release);
+			_writeUnlock(at.parent);
+			m_size.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+	}
+
+	void remove(const K& key) {
+		EpochGuard guard(*this);
+		while (true) {
+			Position at;
+			if (!_descend(key, at)) continue;
+			if (at.node == nullptr) { throw std::runtime_error("error: remove() used on non-existent key"); }
+			if (!_upgrade(at.parent, at.parent_version)) continue;
+			if (!_upgrade(at.node, at.node_version)) {
+				_abortLock(at.parent);
+				continue;
+			}
+			if (!_unlink(at)) {
+				_abortLock(at.node);
+				_abortLock(at.parent);
+				continue;
+			}
+			_writeUnlockObsolete(at.node);
+			_writeUnlock(at.parent);
+			_retire(guard.record(), at.node);
+			m_size.fetch_sub(1, std::memory_order_relaxed);
+			return;
+		}
+	}
+
+	// Removed nodes waiting to be freed, over all threads. Approximate
+	// while writers are active.
+	size_t retired() const {
+		size_t count = 0;
+		for (ThreadRecord* cur = m_registry->head.load(std::memory_order_acquire); cur; cur = cur->next)
+			count += cur->pending.load(std::memory_order_relaxed);
+		return count;
+	}
+
+	// Free every removed node at once. Removes already free them as they
+	// go, this is only for an idle dictionary (no other thread using it).
+	void reclaim() {
+		for (ThreadRecord* cur = m_registry->head.load(std::memory_order_acquire); cur; cur = cur->next) {
+			for (auto& entry : cur->retired) delete entry.second;
+			cur->retired.clear();
+			cur->pending.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	// Not thread-safe
+	void clear() {
+		_destroy(m_sentinel.left.load(std::memory_order_relaxed));
+		m_sentinel.left.store(nullptr, std::memory_order_relaxed);
+		m_size.store(0, std::memory_order_relaxed);
+		reclaim();
+	}
+
+	~ConcurrentDictionary() {
+		clear();
+	}
+};
+
+// Today's approach, for comparison: one mutex around the whole map
+template <typename K, typename D>
+class LockedMap {
+	std::mutex m_lock;
+	std::map<K, D> m_map;
+public:
+	bool contains(const K& key) {
+		std::lock_guard<std::mutex> lock(m_lock);
+		return m_map.count(key) != 0;
+	}
+	bool insert(const K& key, const D& data) {
+		std::lock_guard<std::mutex> lock(m_lock);
+		return m_map.emplace(key, data).second;
+	}
+	bool remove(const K& key) {
+		std::lock_guard<std::mutex> lock(m_lock);
+		return m_map.erase(key) != 0;
+	}
+};
+
+// Each thread does ops operations on random keys, write_percent of them
+// an insert or a remove and the rest lookups. Returns the number of hits.
+template <typename Map>
+long long mixed_workload(Map& map, int threads, int ops, int write_percent, int key_space) {
+	std::atomic<long long> hits(0);
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; t++) {
+		workers.emplace_back([&, t] {
+			std::mt19937 random(t + 1);
+			long long local = 0;
+			for (int i = 0; i < ops; i++) {
+				int key = random() % key_space;
+				int op = random() % 100;
+				if (op >= write_percent) {
+					local += map.contains(key);
+				}	else if (op % 2 == 0) {
+					try { map.insert(key, key); } catch (std::runtime_error&) { }
+				}	else	{
+					try { map.remove(key); } catch (std::runtime_error&) { }
+				}
+			}
+			hits += local;
+		});
+	}
+	for (std::thread& worker : workers) worker.join();
+	return hits;
+}
+
+int main() {
+	ConcurrentDictionary<int, std::string> digits;
+	digits.insert(5, "five");
+	digits.insert(6, "six");
+	digits.insert(4, "four");
+	digits.insert(8, "eight");
+	digits.insert(9, "nine");
+	digits.insert(2, "two");
+	digits.insert(7, "seven");
+	digits.insert(1, "one");
+	digits.insert(3, "three");
+	digits.remove(5);
+	digits.remove(1);
+	std::cout << digits.find(3) << ' ' << digits.find(8) << ' ' << digits.contains(5) << ' ' << digits.size() << '\n';
+
+	// Concurrent check: every thread inserts and then removes its own keys
+	// while the others do the same, the tree must end up empty
+	{
+		ConcurrentDictionary<int, int> shared;
+		std::vector<std::thread> workers;
+		std::atomic<int> missing(0);
+		for (int t = 0; t < 4; t++) {
+			workers.emplace_back([&, t] {
+				for (int i = t; i < 40000; i += 4) shared.insert((i * 7919) % 40000, i);
+				for (int i = t; i < 40000; i += 4)
+					if (shared.find((i * 7919) % 40000) != i) missing++;
+				for (int i = t; i < 40000; i += 4) shared.remove((i * 7919) % 40000);
+			});
+		}
+		for (std::thread& worker : workers) worker.join();
+		std::cout << "missing: " << missing << " left: " << shared.size() << '\n';
+	}
+
+	// Long running churn: removed nodes are freed while the map is in use,
+	// so the number waiting stays bounded however long it runs
+	{
+		ConcurrentDictionary<int, int> churned;
+		std::vector<std::thread> workers;
+		std::atomic<size_t> most_retired(0);
+		for (int t = 0; t < 4; t++) {
+			workers.emplace_back([&, t] {
+				for (int round = 0; round < 200; round++) {
+					for (int i = t; i < 1000; i += 4) churned.insert(i, round);
+					for (int i = t; i < 1000; i += 4) churned.contains(i);
+					for (int i = t; i < 1000; i += 4) churned.remove(i);
+					size_t retired = churned.retired(), seen = most_retired.load();
+					while (retired > seen and !most_retired.compare_exchange_weak(seen, retired)) { }
+				}
+			});
+		}
+		for (std::thread& worker : workers) worker.join();
+		std::cout << "200000 removes, at most " << most_retired << " waiting to be freed\n";
+	}
+
+	// Mixed read/write scaling. The sandbox this was written in has few
+	// cores, run it on the target machine for real numbers.
+	const int key_space = 100000, ops = 400000;
+	int most = std::thread::hardware_concurrency();
+	if (most < 2) most = 2;
+	for (int write_percent : {5, 50}) {
+		std::cout << "\n=== " << 100 - write_percent << "% reads, " << write_percent << "% writes ===";
+		for (int threads = 1; threads <= 16 and threads <= 2 * most; threads *= 2) {
+			std::cout << "\n--- " << threads << " threads x " << ops << " ops ---";
+			ConcurrentDictionary<int, int> olc;
+			LockedMap<int, int> locked;
+			for (int i = 0; i < key_space; i += 2) {
+				int key = (int) ((i * 2654435761u) % key_space);
+				if (!olc.contains(key)) olc.insert(key, key);
+				locked.insert(key, key);
+			}
+			{
+				Timer t("mutex + std::map");
+				mixed_workload(locked, threads, ops, write_percent, key_space);
+			}
+			{
+				Timer t("ConcurrentDictionary");
+				mixed_workload(olc, threads, ops, write_percent, key_space);
+			}
+		}
+	}
+	return 0;
+}
@@ -1,5 +1,114 @@
 #include <iostream>
 #include <utility>
+#include <iterator>
+#include <vector>
+#include <type_traits>
+#include <chrono>
+#include <random>
+#include <cmath>
+
+// Timer Class for benchmarking
+class Timer {
+	std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+	long long elapsed_time;
+	const char* str;
+public:
+	Timer(const char* _str = ""): str(_str) {
+		start = std::chrono::high_resolution_clock::now();
+
+	}
+	~Timer() {
+		end = std::chrono::high_resolution_clock::now();
+		elapsed_time = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+		std::cout << "\n" << str << " Elapsed Time: " << elapsed_time << "ms\n";
+	}
+
+};
+
+
+// Read-only snapshot of a Dictionary (see Dictionary::freeze)
+// Keys are stored in Eytzinger (BFS) order: the root at index 1 and the
+// children of k at 2k and 2k + 1, with the data in a parallel array. A
+// lookup is a branch-free descent over one contiguous array, and the
+// cache line holding the node four levels down is prefetched on every step.
+template <typename K, typename D>
+class FrozenDictionary {
+private:
+	std::vector<K> m_keys;
+	std::vector<D> m_data;
+	size_t m_size;
+
+	// Keys sharing one 64 byte cache line, k * BLOCK is the first
+	// descendant of k log2(BLOCK) levels down
+	static constexpr size_t BLOCK = sizeof(K) >= 64 ? 1 : 64 / sizeof(K);
+
+	// Eytzinger position k takes the next in-order rank
+	void _layout(std::vector<size_t>& rank, size_t k, size_t& next) const {
+		if (k > m_size) return;
+		_layout(rank, 2 * k, next);
+		rank[k] = next++;
+		_layout(rank, 2 * k + 1, next);
+	}
+
+	size_t _search(const K& key) const {
+		size_t k = 1;
+		while (k <= m_size) {
+#if defined(__GNUC__)
+			__builtin_prefetch(m_keys.data() + k * BLOCK);
+#endif
+			k = 2 * k + (m_keys[k] < key);
+		}
+		// Every right turn appended a 1 bit, and the answer (the first key
+		// not less than key) is where the last left turn happened, so drop
+		// the trailing ones and one more bit
+#if defined(__GNUC__)
+		k >>= __builtin_ffsll(~k);
+#else
+		while (k & 1) k >>= 1;
+		k >>= 1;
+#endif
+		return k;
+	}
+
+public:
+	// sorted_keys ascending, sorted_data[i] belongs to sorted_keys[i]
+	FrozenDictionary(const std::vector<K>& sorted_keys, const std::vector<D>& sorted_data)
+		: m_size(sorted_keys.size()) {
+		if (m_size == 0) return;
+		std::vector<size_t> rank(m_size + 1);
+		size_t next = 0;
+		_layout(rank, 1, next);
+
+		// Slot 0 is never searched, it only keeps the array 1-indexed
+		m_keys.reserve(m_size + 1);
+		m_data.reserve(m_size + 1);
+		m_keys.push_back(sorted_keys[0]);
+		m_data.push_back(sorted_data[0]);
+		for (size_t k = 1; k <= m_size; k++) {
+			m_keys.push_back(sorted_keys[rank[k]]);
+			m_data.push_back(sorted_data[rank[k]]);
+		}
+	}
+
+	size_t size() const {
+		return m_size;
+	}
+
+	bool empty() const {
+		return m_size == 0;
+	}
+
+	bool contains(const K& key) const {
+		size_t k = _search(key);
+		return k != 0 and m_keys[k] == key;
+	}
+
+	const D& find(const K& key) const {
+		size_t k = _search(key);
+		if (k == 0 or !(m_keys[k] == key)) { throw std::runtime_error("error: key not found"); }
+		return m_data[k];
+	}
+};
 
 
 template <typename K, typename D>
@@ -11,50 +120,259 @@ private:
 		D data;
 
 		TreeNode *left, *right;
+		// nullptr at the root. Lets iterators climb back up without
+		// keeping a path of their own.
+		TreeNode* parent;
+		// Number of nodes in the subtree rooted here (this one included)
+		size_t size;
 		TreeNode(const K& key, const D& data)
-			: key(key), data(data), left(nullptr), right(nullptr) { }
+			: key(key), data(data), left(nullptr), right(nullptr), parent(nullptr), size(1) { }
+	};
+
+	// In-order iterator
+	// Just a node pointer, it never allocates. Stepping forward goes to the
+	// leftmost node of the right subtree when there is one, otherwise it
+	// climbs parent links until it comes up out of a left subtree. Every
+	// edge is walked down once and up once over a full scan, so a step is
+	// O(1) amortised whatever the shape of the tree.
+	class Iterator {
+	private:
+		TreeNode* m_node;
+	public:
+		explicit Iterator(TreeNode* node = nullptr)
+			: m_node(node)
+		{}
+		Iterator& operator++() {
+			m_node = _successor(m_node);
+			return *this;
+		}
+		Iterator operator++(int) {
+			Iterator temp = *this;
+			m_node = _successor(m_node);
+			return temp;
+		}
+		const TreeNode* operator->() const {
+			return m_node;
+		}
+		const TreeNode& operator*() const {
+			return *m_node;
+		}
+		bool operator==(const Iterator& other) const {
+			return m_node == other.m_node;
+		}
+		bool operator!=(const Iterator& other) const {
+			return m_node != other.m_node;
+		}
+	};
+
+	// Per-tree node allocator
+	// Nodes are carved out of geometrically growing blocks, removed nodes
+	// are recycled through a freelist (chained through their own memory),
+	// and release() hands every block back at once.
+	class NodeArena {
+	private:
+		std::vector<TreeNode*> m_blocks;
+		TreeNode* m_free;
+		size_t m_used, m_capacity;
+
+		static const size_t FIRST_BLOCK = 32, LARGEST_BLOCK = 4096;
+
+		static TreeNode*& _next(TreeNode* node) {
+			return *reinterpret_cast<TreeNode**>(node);
+		}
+
+		void* _take() {
+			if (m_free) {
+				TreeNode* node = m_free;
+				m_free = _next(node);
+				return node;
+			}
+			if (m_used == m_capacity) {
+				m_capacity = m_blocks.empty() ? FIRST_BLOCK : 2 * m_capacity < LARGEST_BLOCK ? 2 * m_capacity : LARGEST_BLOCK;
+				m_blocks.push_back(static_cast<TreeNode*>(::operator new(m_capacity * sizeof(TreeNode))));
+				m_used = 0;
+			}
+			return m_blocks.back() + m_used++;
+		}
+
+		void _give_back(void* memory) {
+			TreeNode* node = static_cast<TreeNode*>(memory);
+			_next(node) = m_free;
+			m_free = node;
+		}
+
+	public:
+		NodeArena()
+			: m_free(nullptr), m_used(0), m_capacity(0) { }
+
+		NodeArena(const NodeArena&) = delete;
+		NodeArena& operator=(const NodeArena&) = delete;
+
+		TreeNode* allocate(const K& key, const D& data) {
+			void* memory = _take();
+			try {
+				return new(memory) TreeNode(key, data);
+			}	catch (...)	{
+				_give_back(memory);
+				throw;
+			}
+		}
+
+		void deallocate(TreeNode* node) {
+			node->~TreeNode();
+			_give_back(node);
+		}
+
+		// Free every block in one go. Nodes still in use are not destroyed,
+		// the owner has to do that first if K or D need it.
+		void release() {
+			for (TreeNode* block : m_blocks) ::operator delete(block);
+			m_blocks.clear();
+			m_free = nullptr;
+			m_used = m_capacity = 0;
+		}
+
+		~NodeArena() {
+			release();
+		}
 	};
 
 	TreeNode *m_head;
+	NodeArena m_arena;
+	// Scapegoat mode (see set_balance), 1 when it is off. m_max_size is the
+	// largest size since the tree was last rebuilt as a whole.
+	double m_alpha;
+	size_t m_max_size;
+
+	static TreeNode* _leftmost(TreeNode* cur) {
+		if (cur == nullptr) return cur;
+		while (cur->left) cur = cur->left;
+		return cur;
+	}
+
+	static TreeNode* _successor(TreeNode* node) {
+		if (node->right) return _leftmost(node->right);
+		while (node->parent and node == node->parent->right) node = node->parent;
+		return node->parent;
+	}
+
+	// Number of keys smaller than key, or not larger when inclusive O(height)
+	size_t _rank(const K& key, bool inclusive) const {
+		size_t rank = 0;
+		const TreeNode* cur = m_head;
+		while (cur) {
+			if (cur->key < key or (inclusive and cur->key == key)) {
+				rank += _size(cur->left) + 1;
+				cur = cur->right;
+			}	else	{
+				cur = cur->left;
+			}
+		}
+		return rank;
+	}
 
 	TreeNode*& _find(const K& key, TreeNode*& cur) const {
+		// The search walks down with a pointer to the child pointer we are
+		// looking at ("slot"), so that we can hand back a reference to the
+		// tree's actual stored pointer. It is a loop rather than recursion so
+		// that a deep, unbalanced tree cannot overflow the stack.
+		TreeNode** slot = &cur;
+		while (true) {
+			// [Stop 1: When the key is not found]
+			// The slot will hold nullptr if the tree is empty, or if we descend
+			// below the lowest level (leaves) without finding the key. Then we
+			// return that nullptr slot and the outer "find" function will report
+			// it as an error. Or, if we were calling insert, then the slot
+			// returned is the position where the item should be placed.
+			//   Note: We specifically return the pointer at this position (and
+			// not the "nullptr" literal) since this function returns by reference.
+			if (*slot == nullptr)  return *slot;
+
+			// [Stop 2: When the key is found]
+			// If we find a key that matches by value, then return the current TreeNode*
+			if (key == (*slot)->key)  return *slot;
+
+			// [When we need to search left]
+			// If the key we're looking for is smaller than the current node's key,
+			// then we should look to the left next.
+			if (key < (*slot)->key)  slot = &(*slot)->left;
+
+			// [When we need to search right]
+			// Otherwise, implicitly, the key we're looking for is larger than the
+			// current node's key. So we should search to the right next.
+			else  slot = &(*slot)->right;
+		}
+	}
 
-		// [Base case 1: When the key is not found]
-		// cur will be nullptr if the tree is empty, or if we descend below the
-		// lowest level (leaves) without finding the key. Then we return nullptr and the
-		// outer "find" function (which calls "_find") will report that as an
-		// error. Or, if we were calling insert, then the pointer returned is the
-		// position where the item should be placed.
-		//   Note: The "cur" we return in this case is equal to nullptr, but
-		// it's important to write "return cur;" and not "return nullptr;" since
-		// this function returns by reference. We specifically want to return the
-		// pointer at this position we found. This is true whether we want to
-		// replace it, as when we're doing an insertion, or if this is a failed
-		// "find" operation that should report an error. We should not return a
-		// reference to the "nullptr" literal, and we should avoid making
-		// references to temporary constants like numerical literals in any case.
-		if (cur == nullptr)  return cur;
-
-		// [Base case 2: When the key is found]
-		// If we find a key that matches by value, then return the current TreeNode*
-		else if (key == cur->key)  return cur;
-
-		// [When we need to search left]
-		// If the key we're looking for is smaller than the current node's key,
-		// then we should look to the left next.
-		else if (key < cur->key)  return _find(key, cur->left);
-
-		// [When we need to search right]
-		// Otherwise, implicitly, the key we're looking for is larger than the
-		// current node's key. (We know this because it's not equal and not less.)
-		// So we should search to the right next.
-		else  return _find(key, cur->right);
-
-	}
-
-	TreeNode*& _iop(TreeNode*& cur) const {
-		if (cur->right) return _iop(cur->right);
-		return cur;
+	// Find the in-order predecessor at or below cur. Every node passed on
+	// the way down is about to lose that descendant, so its size shrinks.
+	TreeNode*& _iop(TreeNode*& cur) {
+		TreeNode** slot = &cur;
+		while ((*slot)->right) {
+			(*slot)->size--;
+			slot = &(*slot)->right;
+		}
+		return *slot;
+	}
+
+	static size_t _size(const TreeNode* node) {
+		return node ? node->size : 0;
+	}
+
+	// Walk the search path for key and grow (or shrink) the size of every
+	// node strictly above where key is, or would be. Returns the depth, and
+	// the last node passed (the parent of key) through above.
+	size_t _resizePath(const K& key, bool grow, TreeNode*& above) {
+		size_t depth = 0;
+		TreeNode* cur = m_head;
+		above = nullptr;
+		while (cur and !(key == cur->key)) {
+			if (grow) cur->size++;
+			else cur->size--;
+			above = cur;
+			cur = key < cur->key ? cur->left : cur->right;
+			depth++;
+		}
+		return depth;
+	}
+
+	// Rebuild a subtree into a balanced one in place O(size)
+	void _rebuild(TreeNode*& root) {
+		if (root == nullptr) return;
+		TreeNode* parent = root->parent;
+		_vineToTree(root, _treeToVine(root));
+		_recount(root, parent);
+	}
+
+	// A node just inserted at depth sits deeper than log_{1/alpha}(n), so
+	// some ancestor has a child holding more than alpha of its subtree.
+	// Rebuild the lowest such ancestor (the scapegoat).
+	void _rebuildScapegoat(const K& key) {
+		std::vector<TreeNode**> path;
+		TreeNode** slot = &m_head;
+		while (!(key == (*slot)->key)) {
+			path.push_back(slot);
+			slot = key < (*slot)->key ? &(*slot)->left : &(*slot)->right;
+		}
+		size_t child = 1;
+		for (size_t i = path.size(); i-- > 0;) {
+			TreeNode* node = *path[i];
+			if (child > m_alpha * node->size) {
+				_rebuild(*path[i]);
+				return;
+			}
+			child = node->size;
+		}
+	}
+
+	// Recompute every size and parent in a subtree after it has been
+	// restructured. Only used on balanced subtrees, so the recursion stays
+	// shallow.
+	size_t _recount(TreeNode* node, TreeNode* parent) {
+		if (node == nullptr) return 0;
+		node->parent = parent;
+		node->size = 1 + _recount(node->left, node) + _recount(node->right, node);
+		return node->size;
 	}
 
 	void _printInOrder(TreeNode* node) const {
@@ -72,8 +390,70 @@ private:
 		_printInOrder(node->right);
 		return;
 	}
+
+	// Build a perfectly balanced subtree out of the next n sorted entries.
+	// The left half is built first so that "it" is consumed in order, which
+	// makes the whole build O(n) with only O(log n) recursion depth.
+	template <typename Iter>
+	TreeNode* _build(Iter& it, size_t n) {
+		if (n == 0) return nullptr;
+		TreeNode* left = _build(it, n / 2);
+		TreeNode* node = m_arena.allocate(it->first, it->second);
+		++it;
+		node->left = left;
+		node->right = _build(it, n - n / 2 - 1);
+		if (node->left) node->left->parent = node;
+		if (node->right) node->right->parent = node;
+		node->size = n;
+		return node;
+	}
+
+	// Day-Stout-Warren, step 1: rotate right until the subtree is a sorted
+	// "vine" of right children. Returns the number of nodes. O(n), in place.
+	size_t _treeToVine(TreeNode*& root) {
+		size_t size = 0;
+		TreeNode** slot = &root;
+		while (*slot) {
+			TreeNode* cur = *slot;
+			if (cur->left) {
+				// Rotate right, the left child takes the place of cur
+				TreeNode* left = cur->left;
+				cur->left = left->right;
+				left->right = cur;
+				*slot = left;
+			}	else	{
+				size++;
+				slot = &cur->right;
+			}
+		}
+		return size;
+	}
+
+	// One left rotation on each of the first count nodes down the vine
+	void _compress(TreeNode*& root, size_t count) {
+		TreeNode** slot = &root;
+		while (count--) {
+			TreeNode* child = *slot;
+			TreeNode* grandchild = child->right;
+			child->right = grandchild->left;
+			grandchild->left = child;
+			*slot = grandchild;
+			slot = &grandchild->right;
+		}
+	}
+
+	// Day-Stout-Warren, step 2: fold the vine into a balanced tree whose
+	// last level is filled from the left. O(n), in place.
+	void _vineToTree(TreeNode*& root, size_t size) {
+		size_t full = 1;
+		while (full <= size + 1) full *= 2;
+		full = full / 2 - 1;
+		_compress(root, size - full);
+		for (size = full; size > 1; size /= 2)
+			_compress(root, size / 2);
+	}
 public:
-	Dictionary() : m_head(nullptr) { }
+	Dictionary() : m_head(nullptr), m_alpha(1), m_max_size(0) { }
 
 	bool empty() const {
 		return !m_head;
@@ -83,6 +463,164 @@ public:
 		_printInOrder(m_head);
 	}
 
+	// Number of edges on the longest root to leaf path (-1 when empty)
+	int height() const {
+		int height = -1;
+		std::vector<TreeNode*> level, next;
+		if (m_head) level.push_back(m_head);
+		while (!level.empty()) {
+			height++;
+			next.clear();
+			for (TreeNode* node : level) {
+				if (node->left) next.push_back(node->left);
+				if (node->right) next.push_back(node->right);
+			}
+			level.swap(next);
+		}
+		return height;
+	}
+
+	// Bulk-load an empty dictionary from [first, last), a range of
+	// (key, data) pairs sorted by strictly increasing key. O(n), where n
+	// calls to insert would take O(n^2) on sorted input.
+	template <typename Iter>
+	void build_from_sorted(Iter first, Iter last) {
+		if (m_head) { throw std::runtime_error("error: build_from_sorted() used on a non-empty dictionary"); }
+		size_t n = 0;
+		for (Iter it = first; it != last; ++it, ++n) {
+			if (n > 0 and !(std::prev(it)->first < it->first)) {
+				throw std::runtime_error("error: build_from_sorted() needs strictly increasing keys");
+			}
+		}
+		m_head = _build(first, n);
+		m_max_size = n;
+	}
+
+	// Export an immutable, Eytzinger ordered copy for read-mostly use
+	FrozenDictionary<K, D> freeze() const {
+		std::vector<K> keys;
+		std::vector<D> data;
+		std::vector<TreeNode*> stack;
+		TreeNode* cur = m_head;
+		while (cur or !stack.empty()) {
+			while (cur) {
+				stack.push_back(cur);
+				cur = cur->left;
+			}
+			cur = stack.back();
+			stack.pop_back();
+			keys.push_back(cur->key);
+			data.push_back(cur->data);
+			cur = cur->right;
+		}
+		return FrozenDictionary<K, D>(keys, data);
+	}
+
+	// Flatten the tree and rebuild it perfectly balanced, in place and in
+	// O(n) time without allocating
+	void rebalance() {
+		_rebuild(m_head);
+		m_max_size = size();
+	}
+
+	// Opt in to scapegoat rebalancing. No subtree may hold more than alpha
+	// of its parent's nodes for long: an insert that lands deeper than
+	// log_{1/alpha}(n) rebuilds the subtree that broke the rule, and once
+	// removes shrink the tree below alpha of its peak size the whole tree
+	// is rebuilt. Keeps every operation O(log n) amortised using only the
+	// subtree sizes the nodes already carry. Smaller alpha means a flatter
+	// tree but more rebuilding, 1 turns the mode off.
+	void set_balance(double alpha) {
+		if (!(alpha > 0.5 and alpha <= 1)) { throw std::invalid_argument("error: set_balance() needs alpha in (0.5, 1]"); }
+		m_alpha = alpha;
+		if (m_alpha < 1) rebalance();
+	}
+
+	// Number of entries O(1)
+	size_t size() const {
+		return _size(m_head);
+	}
+
+	// Number of keys less than key O(height), key need not be present
+	size_t rank(const K& key) const {
+		return _rank(key, false);
+	}
+
+	// The entry with exactly k smaller keys (0 based) O(height)
+	Iterator select(size_t k) const {
+		if (k >= size()) { throw std::runtime_error("error: select() index out of range"); }
+		TreeNode* cur = m_head;
+		while (true) {
+			size_t left = _size(cur->left);
+			if (k < left) {
+				cur = cur->left;
+			}	else if (k == left) {
+				return Iterator(cur);
+			}	else	{
+				k -= left + 1;
+				cur = cur->right;
+			}
+		}
+	}
+
+	// Number of keys in [lo, hi] O(height)
+	size_t count_range(const K& lo, const K& hi) const {
+		if (hi < lo) return 0;
+		return _rank(hi, true) - _rank(lo, false);
+	}
+
+	// Nearest-rank percentile: the smallest key with at least p percent of
+	// the keys at or below it, for p in [0, 100]
+	const K& percentile(double p) const {
+		if (empty()) { throw std::runtime_error("error: percentile() used on an empty dictionary"); }
+		if (!(p >= 0 and p <= 100)) { throw std::runtime_error("error: percentile() needs p in [0, 100]"); }
+		size_t k = (size_t) std::ceil(p / 100 * size());
+		return select(k == 0 ? 0 : k - 1)->key;
+	}
+
+	Iterator begin() const {
+		return Iterator(_leftmost(m_head));
+	}
+
+	Iterator end() const {
+		return Iterator();
+	}
+
+	// First entry whose key is not less than key (end() if there is none)
+	Iterator lower_bound(const K& key) const {
+		TreeNode *cur = m_head, *bound = nullptr;
+		while (cur) {
+			if (cur->key < key) {
+				cur = cur->right;
+			}	else	{
+				bound = cur;
+				cur = cur->left;
+			}
+		}
+		return Iterator(bound);
+	}
+
+	// First entry whose key is greater than key (end() if there is none)
+	Iterator upper_bound(const K& key) const {
+		TreeNode *cur = m_head, *bound = nullptr;
+		while (cur) {
+			if (key < cur->key) {
+				bound = cur;
+				cur = cur->left;
+			}	else	{
+				cur = cur->right;
+			}
+		}
+		return Iterator(bound);
+	}
+
+	// Call visit(key, data) for every key in [lo, hi] in ascending order
+	template <typename Visitor>
+	void range(const K& lo, const K& hi, Visitor visit) const {
+		for (Iterator it = lower_bound(lo); it != end() and !(hi < it->key); ++it)
+			visit(it->key, it->data);
+	}
+
 	const D& find(const K& key) {
 		// Find the key in the tree starting at the head.
 		// If found, we receive the tree's actual stored pointer to that node
@@ -102,13 +640,22 @@ public:
 		if (node) { throw std::runtime_error("error: insert() used on an existing key"); }
 
 		// else add a node of key value pair their
-		node = new TreeNode(key, data);
+		node = m_arena.allocate(key, data);
+		// and count it in every subtree on the way down
+		TreeNode* parent;
+		size_t depth = _resizePath(key, true, parent);
+		node->parent = parent;
+
+		if (m_alpha < 1) {
+			if (size() > m_max_size) m_max_size = size();
+			if (depth > std::log((double) size()) / std::log(1 / m_alpha)) _rebuildScapegoat(key);
+		}
 	}
 
 	void _remove(TreeNode*& node) {
 		// Zero child remove:
 		if (node->left == nullptr && node->right == nullptr) {
-			delete node;
+			m_arena.deallocate(node);
 			node = nullptr;
 			return;
 		}
@@ -120,7 +667,8 @@ public:
 			// below this point.
 			TreeNode* temp = node;
 			node = node->left;
-			delete temp;
+			node->parent = temp->parent;
+			m_arena.deallocate(temp);
 			return;
 		}
 		// One-child (right) remove
@@ -128,7 +676,8 @@ public:
 			// Similar to last case
 			TreeNode* temp = node;
 			node = node->right;
-			delete temp;
+			node->parent = temp->parent;
+			m_arena.deallocate(temp);
 			return;
 		}
 		// Two-child remove
@@ -139,23 +688,27 @@ public:
 			// compared to lecture, as noted in other comments here.)
 
 			// Find the IOP (in-order predecessor) of the current node.
-			TreeNode*& iop = _iop(node->left);
-
-
-			K temp_key = iop->key;
-			D temp_data = iop->data;
-
-			iop->key = node->key;
-			iop->data = node->data;
+			// Both this node and the path down to the IOP lose one descendant.
+			node->size--;
+			TreeNode*& iop_slot = _iop(node->left);
+			TreeNode* iop = iop_slot;
+
+			// The IOP has no right child, so it is unlinked like a one-child
+			// (left) remove. It then takes over the node's links and size,
+			// and the node is freed. No key or data is copied, so pointers
+			// and iterators to every other entry stay valid.
+			iop_slot = iop->left;
+			if (iop->left) iop->left->parent = iop->parent;
+			iop->left = node->left;
+			iop->right = node->right;
+			iop->parent = node->parent;
+			iop->size = node->size;
+			if (iop->left) iop->left->parent = iop;
+			iop->right->parent = iop;
 
-
-			node->key = temp_key;
-			node->data = temp_data;
-
-			// This will turn the two child remove case into either no child case
-			// or single left child case and call the remove function again which will
-			// repair the link accordingly
-			_remove(iop);
+			TreeNode* temp = node;
+			node = iop;
+			m_arena.deallocate(temp);
 		}
 	}
 
@@ -169,13 +722,40 @@ public:
 			throw std::runtime_error("error: _remove() used on non-existent key");
 		}
 
-		return _remove(node);
+		TreeNode* parent;
+		_resizePath(key, false, parent);
+		_remove(node);
 
+		if (m_alpha < 1 and size() < m_alpha * m_max_size) rebalance();
+	}
 
+	// Remove every entry O(n), or O(blocks) when K and D are trivially
+	// destructible since then there is nothing to run per node
+	void clear() {
+		if (!std::is_trivially_destructible<K>::value or !std::is_trivially_destructible<D>::value) {
+			// Destroy every node without recursion or a stack: rotate left
+			// children up until the current node has none, then it can go.
+			TreeNode* cur = m_head;
+			while (cur) {
+				if (cur->left) {
+					TreeNode* left = cur->left;
+					cur->left = left->right;
+					left->right = cur;
+					cur = left;
+				}	else	{
+					TreeNode* right = cur->right;
+					cur->~TreeNode();
+					cur = right;
+				}
+			}
+		}
+		m_arena.release();
+		m_head = nullptr;
+		m_max_size = 0;
 	}
 
 	~Dictionary() {
-		while (m_head) remove(m_head->key);
+		clear();
 	}
 };
 
@@ -204,6 +784,80 @@ int main() {
 	std::cout << '\n';
 	digits.printInOrder();
 	std::cout << "\n---------------\n" << digits.find(3) << '\n';
+	for (auto& node : digits)
+		std::cout << node.key << ' ';
+	std::cout << "\n" << digits.lower_bound(5)->key << ' ' << digits.upper_bound(4)->key << '\n';
+	digits.range(3, 7, [](const int& key, const std::string & data) {
+		std::cout << "[" << key << " : " << data << "]";
+	});
+
+	// A sorted insert makes a linked list shaped tree, deep enough to
+	// overflow a recursive descent
+	Dictionary<int, int> deep;
+	for (int i = 0; i < 20000; i++) deep.insert(-i, i);
+	long long sum = 0;
+	deep.range(-100, -1, [&sum](const int& key, const int&) {sum += key;});
+	std::cout << "\n" << deep.find(-19999) << ' ' << sum << '\n';
+	{
+		// Iterators climb parent links, so even here a full scan is O(n)
+		Timer t("full scan of the 20000 deep tree");
+		sum = 0;
+		for (auto& node : deep) sum += node.key;
+	}
+	std::cout << sum << '\n';
+	std::cout << "height: " << deep.height();
+	deep.rebalance();
+	std::cout << " after rebalance: " << deep.height() << '\n';
+
+	// The same sorted insert with scapegoat rebalancing stays shallow
+	Dictionary<int, int> scapegoat;
+	scapegoat.set_balance(0.7);
+	for (int i = 0; i < 20000; i++) scapegoat.insert(-i, i);
+	std::cout << "scapegoat height: " << scapegoat.height();
+	for (int i = 0; i < 15000; i++) scapegoat.remove(-i);
+	std::cout << " after removes: " << scapegoat.height() << '\n';
+
+	std::vector<std::pair<int, int>> sorted;
+	for (int i = 0; i < 1000000; i++) sorted.push_back({2 * i, i});
+	Dictionary<int, int> loaded;
+	loaded.build_from_sorted(sorted.begin(), sorted.end());
+	std::cout << loaded.find(1999998) << ' ' << loaded.height() << '\n';
+	std::cout << loaded.size() << ' ' << loaded.rank(1000) << ' ' << loaded.select(10)->key << ' '
+	          << loaded.count_range(10, 20) << ' ' << loaded.percentile(99) << '\n';
+	FrozenDictionary<int, int> frozen = loaded.freeze();
+	std::cout << frozen.find(1999998) << ' ' << frozen.find(0) << ' ' << frozen.contains(7) << '\n';
+	loaded.clear();
+	std::cout << loaded.empty() << '\n';
+	loaded.insert(1, 1);
+
+	// Pointer chasing find vs the Eytzinger snapshot
+	for (int n : {100000, 1000000, 4000000}) {
+		std::cout << "\n=== " << n << " keys ===";
+		Dictionary<int, int> tree;
+		{
+			std::vector<std::pair<int, int>> pairs;
+			pairs.reserve(n);
+			for (int i = 0; i < n; i++) pairs.push_back({2 * i, i});
+			tree.build_from_sorted(pairs.begin(), pairs.end());
+		}
+		FrozenDictionary<int, int> snapshot = tree.freeze();
+
+		const int queries = 2000000;
+		std::vector<int> keys(queries);
+		std::mt19937 random(7);
+		for (int& key : keys) key = 2 * (random() % n);
+
+		long long checksum = 0;
+		{
+			Timer t("Dictionary::find");
+			for (int key : keys) checksum += tree.find(key);
+		}
+		{
+			Timer t("FrozenDictionary::find");
+			for (int key : keys) checksum -= snapshot.find(key);
+		}
+		std::cout << "checksum (should be 0): " << checksum << '\n';
+	}
 	digits.remove(3);
 	std::cout << "\n---------------\n" << digits.find(3) << '\n';
 	return 0;
@@ -0,0 +1,409 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+// Persistent (path-copying) binary search tree
+// Nodes are never modified once built. insert and remove copy only the
+// nodes on the search path and share every other subtree with the version
+// they started from, so each update yields a new root while every older
+// root stays a complete, valid tree. Nodes are reference counted and are
+// freed when the last version that reaches them is dropped.
+template <typename K, typename D>
+class PersistentDictionary {
+private:
+	class TreeNode {
+	public:
+		const K key;
+		const D data;
+		TreeNode* const left;
+		TreeNode* const right;
+		// Number of nodes in the subtree rooted here (this one included)
+		const size_t size;
+		// Parents and versions pointing at this node
+		mutable std::atomic<size_t> refs;
+
+		// Takes over one reference to each child
+		TreeNode(const K& key, const D& data, TreeNode* left, TreeNode* right)
+			: key(key), data(data), left(left), right(right),
+			  size(1 + _size(left) + _size(right)), refs(1) { }
+	};
+
+	static size_t _size(const TreeNode* node) {
+		return node ? node->size : 0;
+	}
+
+	static TreeNode* _retain(TreeNode* node) {
+		if (node) node->refs.fetch_add(1, std::memory_order_relaxed);
+		return node;
+	}
+
+	// Drop one reference, freeing whatever is no longer reachable. Dropping
+	// a shared node is a single atomic decrement, the explicit stack (an
+	// unbalanced tree can be very deep) is only built once something is
+	// actually freed, so taking and dropping snapshots never allocates.
+	static void _release(TreeNode* node) {
+		if (node == nullptr or node->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+		std::vector<TreeNode*> stack;
+		while (true) {
+			if (node->left) stack.push_back(node->left);
+			if (node->right) stack.push_back(node->right);
+			delete node;
+			// Next child whose last reference this was
+			do {
+				if (stack.empty()) return;
+				node = stack.back();
+				stack.pop_back();
+			} while (node->refs.fetch_sub(1, std::memory_order_acq_rel) != 1);
+		}
+	}
+
+	// new TreeNode that gives the child references back if it throws
+	static TreeNode* _make(const K& key, const D& data, TreeNode* left, TreeNode* right) {
+		try {
+			return new TreeNode(key, data, left, right);
+		}	catch (...)	{
+			_release(left);
+			_release(right);
+			throw;
+		}
+	}
+
+	// Rebuild the search path above a replaced subtree. path[i + 1] is a
+	// child of path[i], and sub takes the place of the child of path.back()
+	// in the direction of key. Returns the new root.
+	static TreeNode* _copyPath(const std::vector<TreeNode*>& path, const K& key, TreeNode* sub) {
+		for (size_t i = path.size(); i-- > 0;) {
+			TreeNode* node = path[i];
+			if (key < node->key) sub = _make(node->key, node->data, sub, _retain(node->right));
+			else sub = _make(node->key, node->data, _retain(node->left), sub);
+		}
+		return sub;
+	}
+
+	static TreeNode* _insert(TreeNode* root, const K& key, const D& data) {
+		std::vector<TreeNode*> path;
+		for (TreeNode* cur = root; cur; cur = key < cur->key ? cur->left : cur->right) {
+			if (key == cur->key) { throw std::runtime_error("error: insert() used on an existing key"); }
+			path.push_back(cur);
+		}
+		return _copyPath(path, key, _make(key, data, nullptr, nullptr));
+	}
+
+	static TreeNode* _remove(TreeNode* root, const K& key) {
+		std::vector<TreeNode*> path;
+		TreeNode* node = root;
+		while (node and !(key == node->key)) {
+			path.push_back(node);
+			node = key < node->key ? node->left : node->right;
+		}
+		if (!node) { throw std::runtime_error("error: remove() used on non-existent key"); }
+
+		TreeNode* sub;
+		if (node->left == nullptr) {
+			sub = _retain(node->right);
+		}	else if (node->right == nullptr) {
+			sub = _retain(node->left);
+		}	else	{
+			// Two children: the IOP (in-order predecessor) takes the place
+			// of node, so the right spine of the left subtree is copied
+			// without the IOP
+			std::vector<TreeNode*> spine;
+			TreeNode* iop = node->left;
+			while (iop->right) {
+				spine.push_back(iop);
+				iop = iop->right;
+			}
+			sub = _retain(iop->left);
+			for (size_t i = spine.size(); i-- > 0;)
+				sub = _make(spine[i]->key, spine[i]->data, _retain(spine[i]->left), sub);
+			sub = _make(iop->key, iop->data, sub, _retain(node->right));
+		}
+		return _copyPath(path, key, sub);
+	}
+
+	static void _printInOrder(const TreeNode* node) {
+		if (node == nullptr) {
+			std::cout << " ";
+			return;
+		}
+		_printInOrder(node->left);
+		std::cout << "[" << node->key << " : " << node->data << "]";
+		_printInOrder(node->right);
+	}
+
+public:
+	// One immutable version of the tree. Copying a snapshot is O(1), and a
+	// snapshot stays valid and unchanged for as long as it is held, whatever
+	// happens to the dictionary it was taken from.
+	class Snapshot {
+	private:
+		TreeNode* m_root;
+		friend class PersistentDictionary;
+
+		// Takes over one reference to root
+		explicit Snapshot(TreeNode* root)
+			: m_root(root) { }
+
+	public:
+		Snapshot()
+			: m_root(nullptr) { }
+
+		Snapshot(const Snapshot& other)
+			: m_root(_retain(other.m_root)) { }
+
+		Snapshot(Snapshot&& other) noexcept
+			: m_root(other.m_root) {
+			other.m_root = nullptr;
+		}
+
+		Snapshot& operator=(Snapshot other) {
+			std::swap(m_root, other.m_root);
+			return *this;
+		}
+
+		~Snapshot() {
+			_release(m_root);
+		}
+
+		size_t size() const {
+			return _size(m_root);
+		}
+
+		bool empty() const {
+			return m_root == nullptr;
+		}
+
+		const D& find(const K& key) const {
+			const TreeNode* cur = m_root;
+			while (cur and !(key == cur->key))
+				cur = key < cur->key ? cur->left : cur->right;
+			if (cur == nullptr) { throw std::runtime_error("error: key not found"); }
+			return cur->data;
+		}
+
+		bool contains(const K& key) const {
+			const TreeNode* cur = m_root;
+			while (cur and !(key == cur->key))
+				cur = key < cur->key ? cur->left : cur->right;
+			return cur != nullptr;
+		}
+
+		// Call visit(key, data) for every key in [lo, hi] in ascending order
+		template <typename Visitor>
+		void range(const K& lo, const K& hi, Visitor visit) const {
+			std::vector<const TreeNode*> stack;
+			const TreeNode* cur = m_root;
+			while (cur or !stack.empty()) {
+				// Only descend left while there can be keys >= lo down there
+				while (cur) {
+					if (cur->key < lo) {
+						cur = cur->right;
+					}	else	{
+						stack.push_back(cur);
+						cur = cur->left;
+					}
+				}
+				if (stack.empty() or hi < stack.back()->key) return;
+				cur = stack.back();
+				stack.pop_back();
+				visit(cur->key, cur->data);
+				cur = cur->right;
+			}
+		}
+
+		// New versions, this one is left as it is. O(height) new nodes.
+		Snapshot insert(const K& key, const D& data) const {
+			return Snapshot(_insert(m_root, key, data));
+		}
+
+		Snapshot remove(const K& key) const {
+			return Snapshot(_remove(m_root, key));
+		}
+
+		void printInOrder() const {
+			_printInOrder(m_root);
+		}
+	};
+
+private:
+	// The published version, holding one reference to its root
+	std::atomic<TreeNode*> m_root;
+	// Readers between loading m_root and retaining it, split in two by
+	// m_phase so that a writer only waits for the readers that may have
+	// seen the version it is retiring, never for newly arriving ones.
+	// A reader only counts once m_phase is confirmed unchanged after its
+	// increment, so a writer's drain can never miss it.
+	mutable std::atomic<size_t> m_readers[2];
+	std::atomic<size_t> m_phase;
+	// Writers take turns, readers never touch it
+	std::mutex m_writer;
+
+	// Swap in a new root and drop the old one once no reader can still be
+	// about to retain it
+	void _publish(TreeNode* root) {
+		TreeNode* old = m_root.exchange(root);
+		size_t phase = m_phase.fetch_add(1);
+		while (m_readers[phase & 1].load() != 0) std::this_thread::yield();
+		_release(old);
+	}
+
+public:
+	PersistentDictionary()
+		: m_root(nullptr), m_phase(0) {
+		m_readers[0] = m_readers[1] = 0;
+	}
+
+	PersistentDictionary(const PersistentDictionary&) = delete;
+	PersistentDictionary& operator=(const PersistentDictionary&) = delete;
+
+	// The current version. Lock-free: readers never wait for a writer, and
+	// a writer only waits for readers still inside this function.
+	Snapshot snapshot() const {
+		for (;;) {
+			size_t phase = m_phase.load();
+			std::atomic<size_t>& readers = m_readers[phase & 1];
+			readers.fetch_add(1);
+			// A writer moved on between the two loads and may already have
+			// drained this counter, so it could miss us: back out and retry
+			if (m_phase.load() != phase) {
+				readers.fetch_sub(1, std::memory_order_release);
+				continue;
+			}
+			TreeNode* root = _retain(m_root.load());
+			readers.fetch_sub(1, std::memory_order_release);
+			return Snapshot(root);
+		}
+	}
+
+	void insert(const K& key, const D& data) {
+		std::lock_guard<std::mutex> lock(m_writer);
+		_publish(_insert(m_root.load(std::memory_order_relaxed), key, data));
+	}
+
+	void remove(const K& key) {
+		std::lock_guard<std::mutex> lock(m_writer);
+		_publish(_remove(m_root.load(std::memory_order_relaxed), key));
+	}
+
+	// Apply several changes as one version: edit gets the current snapshot
+	// and returns the one to publish. Readers see all of it or none of it.
+	template <typename Edit>
+	void update(Edit edit) {
+		std::lock_guard<std::mutex> lock(m_writer);
+		Snapshot next = edit(Snapshot(_retain(m_root.load(std::memory_order_relaxed))));
+		TreeNode* root = next.m_root;
+		next.m_root = nullptr;
+		_publish(root);
+	}
+
+	~PersistentDictionary() {
+		_release(m_root.load());
+	}
+};
+
+int main() {
+	PersistentDictionary<int, std::string> digits;
+	digits.insert(5, "five");
+	digits.insert(6, "six");
+	digits.insert(4, "four");
+	digits.insert(8, "eight");
+	digits.insert(9, "nine");
+	digits.insert(2, "two");
+	digits.insert(7, "seven");
+	digits.insert(1, "one");
+	digits.insert(3, "three");
+
+	// Old versions are unaffected by later writes
+	auto before = digits.snapshot();
+	digits.remove(5);
+	digits.remove(1);
+	auto after = digits.snapshot();
+	before.printInOrder();
+	std::cout << '\n';
+	after.printInOrder();
+	std::cout << "\n" << before.size() << ' ' << after.size() << ' ' << before.contains(5) << after.contains(5) << '\n';
+
+	// Snapshots are values, updating one gives a new version
+	auto branch = after.insert(10, "ten").remove(9);
+	branch.range(3, 10, [](const int& key, const std::string & data) {
+		std::cout << "[" << key << " : " << data << "]";
+	});
+	std::cout << "\n---------------\n";
+
+	// Readers never lock and always see a consistent version while one
+	// writer keeps publishing. Every version holds keys 0 .. n-1 except
+	// for one batch of "moving" keys, added and removed in one update.
+	PersistentDictionary<int, int> shared;
+	const int n = 10000, rounds = 2000;
+	for (int i = 0; i < n; i++) shared.insert((i * 7919) % n, i);
+	std::atomic<bool> done(false);
+	std::vector<std::thread> readers;
+	for (int r = 0; r < 4; r++) {
+		readers.emplace_back([&] {
+			while (!done.load()) {
+				auto version = shared.snapshot();
+				size_t count = 0;
+				version.range(n, 2 * n, [&count](const int&, const int&) {count++;});
+				if (version.size() != n + count or (count != 0 and count != 10))
+					std::cout << "torn read\n";
+			}
+		});
+	}
+	for (int i = 0; i < rounds; i++) {
+		shared.update([&](PersistentDictionary<int, int>::Snapshot version) {
+			for (int k = n; k < n + 10; k++)
+				version = i % 2 == 0 ? version.insert(k, i) : version.remove(k);
+			return version;
+		});
+	}
+	done = true;
+	for (auto& reader : readers) reader.join();
+	std::cout << shared.snapshot().size() << ' ' << shared.snapshot().find(42) << '\n';
+
+	// Stress: several writers churn a small tree (so old versions are freed
+	// all the time) while many threads take and read snapshots. Each writer
+	// owns its own keys, and every snapshot must be a valid search tree.
+	{
+		PersistentDictionary<int, int> churned;
+		const int writers = 4, takers = 8, keysPerWriter = 64, writes = 20000;
+		std::atomic<bool> stop(false);
+		std::atomic<size_t> taken(0), broken(0);
+		std::vector<std::thread> threads;
+		for (int r = 0; r < takers; r++) {
+			threads.emplace_back([&] {
+				while (!stop.load()) {
+					auto version = churned.snapshot();
+					int previous = -1;
+					size_t count = 0;
+					version.range(0, writers * keysPerWriter, [&](const int& key, const int& data) {
+						if (key <= previous or data != key) broken++;
+						previous = key;
+						count++;
+					});
+					if (count != version.size()) broken++;
+					taken++;
+				}
+			});
+		}
+		std::vector<std::thread> writing;
+		for (int w = 0; w < writers; w++) {
+			writing.emplace_back([&, w] {
+				std::vector<bool> present(keysPerWriter, false);
+				for (int i = 0; i < writes; i++) {
+					int slot = (i * 37) % keysPerWriter, key = w * keysPerWriter + slot;
+					if (present[slot]) churned.remove(key);
+					else churned.insert(key, key);
+					present[slot] = !present[slot];
+				}
+			});
+		}
+		for (auto& writer : writing) writer.join();
+		stop = true;
+		for (auto& thread : threads) thread.join();
+		std::cout << taken.load() << " snapshots, " << broken.load() << " broken\n";
+	}
+	return 0;
+}
@@ -0,0 +1,722 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <cstring>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Timer Class for benchmarking
+class Timer {
+	std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+	long long elapsed_time;
+	const char* str;
+public:
+	Timer(const char* _str = ""): str(_str) {
+		start = std::chrono::high_resolution_clock::now();
+
+	}
+	~Timer() {
+		end = std::chrono::high_resolution_clock::now();
+		elapsed_time = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+		std::cout << "\n" << str << " Elapsed Time: " << elapsed_time << "ms\n";
+	}
+
+};
+
+
+// Adaptive radix tree (ART) keyed by std::string
+// Each inner node branches on one byte of the key, so a lookup inspects
+// every key byte at most once instead of doing O(log n) whole-string
+// comparisons. Inner nodes come in four sizes (4, 16, 48 and 256
+// children) and grow or shrink as children come and go, and a chain of
+// single-child nodes is collapsed into a prefix stored in the node below
+// (path compression). Leaves hold the whole key, so a leaf can sit as
+// high up as the point where its key becomes unique.
+template <typename D>
+class RadixDictionary {
+private:
+	enum Type : uint8_t { LEAF, NODE4, NODE16, NODE48, NODE256 };
+
+	class Node {
+	public:
+		const Type type;
+		Node(Type type)
+			: type(type) { }
+	};
+
+	class Leaf : public Node {
+	public:
+		const std::string key;
+		D data;
+		Leaf(const std::string& key, const D& data)
+			: Node(LEAF), key(key), data(data) { }
+	};
+
+	class Inner : public Node {
+	public:
+		uint16_t count;
+		// Compressed path: bytes every key below here has in common
+		std::string prefix;
+		// The key that ends exactly after prefix, if there is one. Keys can
+		// be prefixes of each other, so there is no terminator byte to
+		// branch on.
+		Leaf* end;
+		Inner(Type type)
+			: Node(type), count(0), end(nullptr) { }
+	};
+
+	// Up to 4 (16) children, keys kept sorted
+	class Node4 : public Inner {
+	public:
+		uint8_t keys[4];
+		Node* children[4];
+		Node4()
+			: Inner(NODE4) { }
+	};
+
+	class Node16 : public Inner {
+	public:
+		uint8_t keys[16];
+		Node* children[16];
+		Node16()
+			: Inner(NODE16) { }
+	};
+
+	// index[byte] is 1 + the slot in children, 0 when absent
+	class Node48 : public Inner {
+	public:
+		uint8_t index[256];
+		Node* children[48];
+		Node48()
+			: Inner(NODE48) {
+			std::memset(index, 0, sizeof(index));
+			std::fill(children, children + 48, nullptr);
+		}
+	};
+
+	class Node256 : public Inner {
+	public:
+		Node* children[256];
+		Node256()
+			: Inner(NODE256) {
+			std::fill(children, children + 256, nullptr);
+		}
+	};
+
+	Node* m_root;
+	size_t m_size;
+
+	static uint8_t _byte(const std::string& key, size_t depth) {
+		return static_cast<uint8_t>(key[depth]);
+	}
+
+	// Position of byte among the sorted keys of a Node4/Node16
+	static size_t _lowerBound(const uint8_t* keys, size_t count, uint8_t byte) {
+		size_t i = 0;
+		while (i < count and keys[i] < byte) i++;
+		return i;
+	}
+
+	static Node** _findChild(Inner* node, uint8_t byte) {
+		switch (node->type) {
+		case NODE4: {
+			Node4* n = static_cast<Node4*>(node);
+			for (size_t i = 0; i < n->count; i++)
+				if (n->keys[i] == byte) return &n->children[i];
+			return nullptr;
+		}
+		case NODE16: {
+			Node16* n = static_cast<Node16*>(node);
+#if defined(__SSE2__)
+			// Compare byte against all 16 keys at once
+			__m128i matches = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(byte)),
+			                                 _mm_loadu_si128(reinterpret_cast<const __m128i*>(n->keys)));
+			unsigned mask = _mm_movemask_epi8(matches) & ((1u << n->count) - 1);
+			return mask ? &n->children[__builtin_ctz(mask)] : nullptr;
+#else
+			for (size_t i = 0; i < n->count; i++)
+				if (n->keys[i] == byte) return &n->children[i];
+			return nullptr;
+#endif
+		}
+		case NODE48: {
+			Node48* n = static_cast<Node48*>(node);
+			return n->index[byte] ? &n->children[n->index[byte] - 1] : nullptr;
+		}
+		default: {
+			Node256* n = static_cast<Node256*>(node);
+			return n->children[byte] ? &n->children[byte] : nullptr;
+		}
+		}
+	}
+
+	// Move the count, prefix and end leaf over when a node changes size
+	static void _copyHeader(Inner* to, Inner* from) {
+		to->count = from->count;
+		to->prefix.swap(from->prefix);
+		to->end = from->end;
+	}
+
+	// Add a child under a byte that is not present yet. slot is where node
+	// hangs, it is repointed if node has to grow into a bigger type.
+	static void _addChild(Node*& slot, Inner* node, uint8_t byte, Node* child) {
+		switch (node->type) {
+		case NODE4: {
+			Node4* n = static_cast<Node4*>(node);
+			if (n->count < 4) {
+				size_t i = _lowerBound(n->keys, n->count, byte);
+				std::memmove(n->keys + i + 1, n->keys + i, n->count - i);
+				std::memmove(n->children + i + 1, n->children + i, (n->count - i) * sizeof(Node*));
+				n->keys[i] = byte;
+				n->children[i] = child;
+				n->count++;
+				return;
+			}
+			Node16* bigger = new Node16();
+			_copyHeader(bigger, n);
+			std::memcpy(bigger->keys, n->keys, 4);
+			std::memcpy(bigger->children, n->children, 4 * sizeof(Node*));
+			slot = bigger;
+			delete n;
+			return _addChild(slot, bigger, byte, child);
+		}
+		case NODE16: {
+			Node16* n = static_cast<Node16*>(node);
+			if (n->count < 16) {
+				size_t i = _lowerBound(n->keys, n->count, byte);
+				std::memmove(n->keys + i + 1, n->keys + i, n->count - i);
+				std::memmove(n->children + i + 1, n->children + i, (n->count - i) * sizeof(Node*));
+				n->keys[i] = byte;
+				n->children[i] = child;
+				n->count++;
+				return;
+			}
+			Node48* bigger = new Node48();
+			_copyHeader(bigger, n);
+			for (size_t i = 0; i < 16; i++) {
+				bigger->index[n->keys[i]] = i + 1;
+				bigger->children[i] = n->children[i];
+			}
+			slot = bigger;
+			delete n;
+			return _addChild(slot, bigger, byte, child);
+		}
+		case NODE48: {
+			Node48* n = static_cast<Node48*>(node);
+			if (n->count < 48) {
+				size_t i = 0;
+				while (n->children[i]) i++;
+				n->children[i] = child;
+				n->index[byte] = i + 1;
+				n->count++;
+				return;
+			}
+			Node256* bigger = new Node256();
+			_copyHeader(bigger, n);
+			for (size_t b = 0; b < 256; b++)
+				if (n->index[b]) bigger->children[b] = n->children[n->index[b] - 1];
+			slot = bigger;
+			delete n;
+			return _addChild(slot, bigger, byte, child);
+		}
+		default: {
+			Node256* n = static_cast<Node256*>(node);
+			n->children[byte] = child;
+			n->count++;
+			return;
+		}
+		}
+	}
+
+	// Put a leaf under a fresh Node4 whose prefix ends at depth
+	static void _place(Node4* node, Leaf* leaf, size_t depth) {
+		if (leaf->key.size() == depth) {
+			node->end = leaf;
+		}	else	{
+			Node* slot = node;
+			_addChild(slot, node, _byte(leaf->key, depth), leaf);
+		}
+	}
+
+	// After a removal, move node into a smaller type if it got sparse, or
+	// splice it out if only one entry is left (keeping paths compressed)
+	static void _shrink(Node*& slot) {
+		Inner* node = static_cast<Inner*>(slot);
+		switch (node->type) {
+		case NODE4: {
+			Node4* n = static_cast<Node4*>(node);
+			if (n->count == 0) {
+				slot = n->end;
+				delete n;
+			}	else if (n->count == 1 and n->end == nullptr) {
+				Node* child = n->children[0];
+				if (child->type != LEAF) {
+					Inner* below = static_cast<Inner*>(child);
+					below->prefix = n->prefix + static_cast<char>(n->keys[0]) + below->prefix;
+				}
+				slot = child;
+				delete n;
+			}
+			return;
+		}
+		case NODE16: {
+			Node16* n = static_cast<Node16*>(node);
+			if (n->count > 3) return;
+			Node4* smaller = new Node4();
+			_copyHeader(smaller, n);
+			std::memcpy(smaller->keys, n->keys, n->count);
+			std::memcpy(smaller->children, n->children, n->count * sizeof(Node*));
+			slot = smaller;
+			delete n;
+			return;
+		}
+		case NODE48: {
+			Node48* n = static_cast<Node48*>(node);
+			if (n->count > 12) return;
+			Node16* smaller = new Node16();
+			_copyHeader(smaller, n);
+			size_t i = 0;
+			for (size_t b = 0; b < 256; b++) {
+				if (n->index[b]) {
+					smaller->keys[i] = b;
+					smaller->children[i++] = n->children[n->index[b] - 1];
+				}
+			}
+			slot = smaller;
+			delete n;
+			return;
+		}
+		default: {
+			Node256* n = static_cast<Node256*>(node);
+			if (n->count > 40) return;
+			Node48* smaller = new Node48();
+			_copyHeader(smaller, n);
+			size_t i = 0;
+			for (size_t b = 0; b < 256; b++) {
+				if (n->children[b]) {
+					smaller->index[b] = i + 1;
+					smaller->children[i++] = n->children[b];
+				}
+			}
+			slot = smaller;
+			delete n;
+			return;
+		}
+		}
+	}
+
+	static void _removeChild(Node*& slot, Inner* node, uint8_t byte) {
+		switch (node->type) {
+		case NODE4: {
+			Node4* n = static_cast<Node4*>(node);
+			size_t i = _lowerBound(n->keys, n->count, byte);
+			std::memmove(n->keys + i, n->keys + i + 1, n->count - i - 1);
+			std::memmove(n->children + i, n->children + i + 1, (n->count - i - 1) * sizeof(Node*));
+			break;
+		}
+		case NODE16: {
+			Node16* n = static_cast<Node16*>(node);
+			size_t i = _lowerBound(n->keys, n->count, byte);
+			std::memmove(n->keys + i, n->keys + i + 1, n->count - i - 1);
+			std::memmove(n->children + i, n->children + i + 1, (n->count - i - 1) * sizeof(Node*));
+			break;
+		}
+		case NODE48: {
+			Node48* n = static_cast<Node48*>(node);
+			n->children[n->index[byte] - 1] = nullptr;
+			n->index[byte] = 0;
+			break;
+		}
+		default:
+			static_cast<Node256*>(node)->children[byte] = nullptr;
+		}
+		node->count--;
+		_shrink(slot);
+	}
+
+	void _insert(Node*& slot, const std::string& key, const D& data, size_t depth) {
+		if (slot == nullptr) {
+			slot = new Leaf(key, data);
+			return;
+		}
+
+		if (slot->type == LEAF) {
+			// Two keys meet: a Node4 takes over from the bytes they share
+			Leaf* leaf = static_cast<Leaf*>(slot);
+			if (leaf->key == key) { throw std::runtime_error("error: insert() used on an existing key"); }
+			size_t common = depth;
+			while (common < key.size() and common < leaf->key.size() and key[common] == leaf->key[common]) common++;
+			Node4* node = new Node4();
+			node->prefix = key.substr(depth, common - depth);
+			_place(node, leaf, common);
+			_place(node, new Leaf(key, data), common);
+			slot = node;
+			return;
+		}
+
+		Inner* node = static_cast<Inner*>(slot);
+		size_t matched = 0, length = node->prefix.size();
+		while (matched < length and depth + matched < key.size() and node->prefix[matched] == key[depth + matched]) matched++;
+		if (matched < length) {
+			// The key leaves the compressed path part way: split it
+			Node4* parent = new Node4();
+			parent->prefix = node->prefix.substr(0, matched);
+			uint8_t byte = static_cast<uint8_t>(node->prefix[matched]);
+			node->prefix.erase(0, matched + 1);
+			Node* self = parent;
+			_addChild(self, parent, byte, node);
+			_place(parent, new Leaf(key, data), depth + matched);
+			slot = parent;
+			return;
+		}
+
+		depth += length;
+		if (depth == key.size()) {
+			if (node->end) { throw std::runtime_error("error: insert() used on an existing key"); }
+			node->end = new Leaf(key, data);
+			return;
+		}
+		Node** child = _findChild(node, _byte(key, depth));
+		if (child) return _insert(*child, key, data, depth + 1);
+		_addChild(slot, node, _byte(key, depth), new Leaf(key, data));
+	}
+
+	void _remove(Node*& slot, const std::string& key, size_t depth) {
+		if (slot == nullptr) { throw std::runtime_error("error: remove() used on non-existent key"); }
+
+		if (slot->type == LEAF) {
+			// Only reached for the root, deeper leaves are handled by their parent
+			if (static_cast<Leaf*>(slot)->key != key) { throw std::runtime_error("error: remove() used on non-existent key"); }
+			delete static_cast<Leaf*>(slot);
+			slot = nullptr;
+			return;
+		}
+
+		Inner* node = static_cast<Inner*>(slot);
+		if (key.compare(depth, node->prefix.size(), node->prefix) != 0) { throw std::runtime_error("error: remove() used on non-existent key"); }
+		depth += node->prefix.size();
+		if (depth == key.size()) {
+			if (!node->end) { throw std::runtime_error("error: remove() used on non-existent key"); }
+			delete node->end;
+			node->end = nullptr;
+			_shrink(slot);
+			return;
+		}
+
+		uint8_t byte = _byte(key, depth);
+		Node** child = _findChild(node, byte);
+		if (child == nullptr) { throw std::runtime_error("error: remove() used on non-existent key"); }
+		if ((*child)->type == LEAF) {
+			Leaf* leaf = static_cast<Leaf*>(*child);
+			if (leaf->key != key) { throw std::runtime_error("error: remove() used on non-existent key"); }
+			delete leaf;
+			_removeChild(slot, node, byte);
+			return;
+		}
+		_remove(*child, key, depth + 1);
+	}
+
+	// Call visit(key, data) on every leaf below node in key order. A key
+	// that ends at a node sorts before every longer key through it.
+	template <typename Visitor>
+	static void _visit(Node* node, Visitor& visit) {
+		if (node->type == LEAF) {
+			Leaf* leaf = static_cast<Leaf*>(node);
+			visit(leaf->key, leaf->data);
+			return;
+		}
+		Inner* inner = static_cast<Inner*>(node);
+		if (inner->end) visit(inner->end->key, inner->end->data);
+		switch (node->type) {
+		case NODE4: {
+			Node4* n = static_cast<Node4*>(node);
+			for (size_t i = 0; i < n->count; i++) _visit(n->children[i], visit);
+			return;
+		}
+		case NODE16: {
+			Node16* n = static_cast<Node16*>(node);
+			for (size_t i = 0; i < n->count; i++) _visit(n->children[i], visit);
+			return;
+		}
+		case NODE48: {
+			Node48* n = static_cast<Node48*>(node);
+			for (size_t b = 0; b < 256; b++)
+				if (n->index[b]) _visit(n->children[n->index[b] - 1], visit);
+			return;
+		}
+		default: {
+			Node256* n = static_cast<Node256*>(node);
+			for (size_t b = 0; b < 256; b++)
+				if (n->children[b]) _visit(n->children[b], visit);
+			return;
+		}
+		}
+	}
+
+	static void _destroy(Node* node) {
+		if (node == nullptr) return;
+		if (node->type == LEAF) {
+			delete static_cast<Leaf*>(node);
+			return;
+		}
+		Inner* inner = static_cast<Inner*>(node);
+		delete inner->end;
+		switch (node->type) {
+		case NODE4: {
+			Node4* n = static_cast<Node4*>(node);
+			for (size_t i = 0; i < n->count; i++) _destroy(n->children[i]);
+			delete n;
+			return;
+		}
+		case NODE16: {
+			Node16* n = static_cast<Node16*>(node);
+			for (size_t i = 0; i < n->count; i++) _destroy(n->children[i]);
+			delete n;
+			return;
+		}
+		case NODE48: {
+			Node48* n = static_cast<Node48*>(node);
+			for (size_t i = 0; i < 48; i++) _destroy(n->children[i]);
+			delete n;
+			return;
+		}
+		default: {
+			Node256* n = static_cast<Node256*>(node);
+			for (size_t b = 0; b < 256; b++) _destroy(n->children[b]);
+			delete n;
+			return;
+		}
+		}
+	}
+
+	Leaf* _search(const std::string& key) const {
+		Node* node = m_root;
+		size_t depth = 0;
+		while (node) {
+			if (node->type == LEAF) {
+				Leaf* leaf = static_cast<Leaf*>(node);
+				return leaf->key == key ? leaf : nullptr;
+			}
+			Inner* inner = static_cast<Inner*>(node);
+			if (key.compare(depth, inner->prefix.size(), inner->prefix) != 0) return nullptr;
+			depth += inner->prefix.size();
+			if (depth == key.size()) return inner->end;
+			Node** child = _findChild(inner, _byte(key, depth));
+			if (child == nullptr) return nullptr;
+			node = *child;
+			depth++;
+		}
+		return nullptr;
+	}
+
+public:
+	RadixDictionary()
+		: m_root(nullptr), m_size(0) { }
+
+	RadixDictionary(const RadixDictionary&) = delete;
+	RadixDictionary& operator=(const RadixDictionary&) = delete;
+
+	size_t size() const {
+		return m_size;
+	}
+
+	bool empty() const {
+		return m_size == 0;
+	}
+
+	const D& find(const std::string& key) const {
+		Leaf* leaf = _search(key);
+		if (leaf == nullptr) { throw std::runtime_error("error: key not found"); }
+		return leaf->data;
+	}
+
+	bool contains(const std::string& key) const {
+		return _search(key) != nullptr;
+	}
+
+	void insert(const std::string& key, const D& data) {
+		_insert(m_root, key, data, 0);
+		m_size++;
+	}
+
+	void remove(const std::string& key) {
+		_remove(m_root, key, 0);
+		m_size--;
+	}
+
+	// Call visit(key, data) for every key that starts with prefix, in
+	// ascending order. Only the subtree under prefix is walked.
+	template <typename Visitor>
+	void scan_prefix(const std::string& prefix, Visitor visit) const {
+		Node* node = m_root;
+		size_t depth = 0;
+		while (node) {
+			if (node->type == LEAF) {
+				Leaf* leaf = static_cast<Leaf*>(node);
+				if (leaf->key.compare(0, prefix.size(), prefix) == 0) visit(leaf->key, leaf->data);
+				return;
+			}
+			Inner* inner = static_cast<Inner*>(node);
+			size_t overlap = std::min(inner->prefix.size(), prefix.size() - depth);
+			if (inner->prefix.compare(0, overlap, prefix, depth, overlap) != 0) return;
+			if (depth + inner->prefix.size() >= prefix.size()) {
+				_visit(node, visit);
+				return;
+			}
+			depth += inner->prefix.size();
+			Node** child = _findChild(inner, _byte(prefix, depth));
+			if (child == nullptr) return;
+			node = *child;
+			depth++;
+		}
+	}
+
+	void printInOrder() const {
+		scan_prefix("", [](const std::string& key, const D& data) {
+			std::cout << "[" << key << " : " << data << "]";
+		});
+	}
+
+	void clear() {
+		_destroy(m_root);
+		m_root = nullptr;
+		m_size = 0;
+	}
+
+	~RadixDictionary() {
+		clear();
+	}
+};
+
+// Baseline for the benchmark: the insert and find path of Dictionary
+// (5.BinarySearchTree/Dictionary.cpp), one key comparison per level
+template <typename K, typename D>
+class Dictionary {
+private:
+	class TreeNode {
+	public:
+		const K key;
+		const D data;
+		TreeNode *left, *right;
+		TreeNode(const K& key, const D& data)
+			: key(key), data(data), left(nullptr), right(nullptr) { }
+	};
+
+	TreeNode* m_head;
+
+	TreeNode*& _find(const K& key, TreeNode*& cur) const {
+		TreeNode** slot = &cur;
+		while (*slot and !(key == (*slot)->key))
+			slot = key < (*slot)->key ? &(*slot)->left : &(*slot)->right;
+		return *slot;
+	}
+
+public:
+	Dictionary() : m_head(nullptr) { }
+
+	const D& find(const K& key) {
+		TreeNode*& node = _find(key, m_head);
+		if (node == nullptr) { throw std::runtime_error("error: key not found"); }
+		return node->data;
+	}
+
+	void insert(const K& key, const D& data) {
+		TreeNode*& node = _find(key, m_head);
+		if (node) { throw std::runtime_error("error: insert() used on an existing key"); }
+		node = new TreeNode(key, data);
+	}
+
+	~Dictionary() {
+		std::vector<TreeNode*> stack;
+		if (m_head) stack.push_back(m_head);
+		while (!stack.empty()) {
+			TreeNode* node = stack.back();
+			stack.pop_back();
+			if (node->left) stack.push_back(node->left);
+			if (node->right) stack.push_back(node->right);
+			delete node;
+		}
+	}
+};
+
+// Keys shaped like crawled URLs: a few hosts, shared path segments and a
+// numeric tail, so many keys share long prefixes
+std::vector<std::string> url_keys(size_t n, unsigned seed) {
+	const char* hosts[] = {"https://www.example.com", "https://shop.example.com", "https://en.wikipedia.org",
+	                       "https://github.com", "http://news.example.org", "https://api.service.io"};
+	const char* sections[] = {"/wiki/", "/products/", "/users/", "/articles/2024/", "/repos/", "/v2/items/", "/search?q="};
+	std::mt19937 random(seed);
+	std::vector<std::string> keys;
+	keys.reserve(n);
+	for (size_t i = 0; i < n; i++) {
+		std::string key = hosts[random() % 6];
+		key += sections[random() % 7];
+		key += "item-" + std::to_string(random() % 1000) + "/" + std::to_string(i);
+		keys.push_back(key);
+	}
+	return keys;
+}
+
+int main() {
+	RadixDictionary<std::string> words;
+	words.insert("romane", "1");
+	words.insert("romanus", "2");
+	words.insert("romulus", "3");
+	words.insert("rubens", "4");
+	words.insert("ruber", "5");
+	words.insert("rubicon", "6");
+	words.insert("rubicundus", "7");
+	words.insert("rub", "8");
+	words.insert("", "empty");
+	words.printInOrder();
+	std::cout << '\n';
+	words.remove("romulus");
+	words.remove("rub");
+	words.printInOrder();
+	std::cout << "\n" << words.find("rubicon") << ' ' << words.contains("rub") << ' ' << words.size() << '\n';
+	words.scan_prefix("rube", [](const std::string& key, const std::string& data) {
+		std::cout << "[" << key << " : " << data << "]";
+	});
+	std::cout << '\n';
+
+	// String keys: one byte per level vs a full compare per level
+	const size_t n = 500000;
+	std::vector<std::string> keys = url_keys(n, 1);
+	std::vector<std::string> queries = keys;
+	std::shuffle(queries.begin(), queries.end(), std::mt19937(2));
+
+	std::cout << "\n=== " << n << " URL keys ===";
+	RadixDictionary<size_t> radix;
+	Dictionary<std::string, size_t> tree;
+	{
+		Timer t("Dictionary insert");
+		for (size_t i = 0; i < n; i++) tree.insert(keys[i], i);
+	}
+	{
+		Timer t("RadixDictionary insert");
+		for (size_t i = 0; i < n; i++) radix.insert(keys[i], i);
+	}
+	size_t checksum = 0;
+	{
+		Timer t("Dictionary find");
+		for (const std::string& key : queries) checksum += tree.find(key);
+	}
+	{
+		Timer t("RadixDictionary find");
+		for (const std::string& key : queries) checksum -= radix.find(key);
+	}
+	std::cout << "checksum (should be 0): " << checksum << '\n';
+
+	size_t matches = 0;
+	{
+		Timer t("RadixDictionary prefix scan");
+		radix.scan_prefix("https://en.wikipedia.org/wiki/item-42", [&matches](const std::string&, const size_t&) {matches++;});
+	}
+	std::cout << "keys under prefix: " << matches << '\n';
+	return 0;
+}
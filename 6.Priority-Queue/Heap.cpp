@@ -1,39 +1,114 @@
 #include <iostream>
+#include <string>
 #include <vector>
+#include <functional>
+#include <type_traits>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <thread>
 
-template<class T>
+// Timer Class for benchmarking
+class Timer {
+	std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+	long long elapsed_time;
+	const char* str;
+public:
+	Timer(const char* _str = ""): str(_str) {
+		start = std::chrono::high_resolution_clock::now();
+
+	}
+	~Timer() {
+		end = std::chrono::high_resolution_clock::now();
+		elapsed_time = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+		std::cout << "\n" << str << " Elapsed Time: " << elapsed_time << "ms\n";
+	}
+
+};
+
+// d-ary heap, every node has up to ARITY children
+// The root is the smallest element by Compare (std::less, a min heap, by
+// default, std::greater gives a max heap). A wider node means a shallower
+// tree: fewer levels to swim through on insert, and on pop the children
+// compared at each level sit next to each other in memory. The root is
+// stored at index ARITY - 1 so that every group of siblings starts at a
+// multiple of ARITY (for ARITY = 2 this is the classic 1-indexed layout).
+template<class T, size_t ARITY = 4, class Compare = std::less<T>>
 class Heap {
+	static_assert(ARITY >= 2, "a heap node needs at least two children");
+
 	size_t _size;
 	std::vector<T> _data;
+	Compare _compare;
 public:
-	Heap()
-		: _size(0), _data(1)
+	explicit Heap(const Compare& compare = Compare())
+		: _size(0), _data(ROOT), _compare(compare)
 	{}
 
+	// Build from a range in O(n)
+	template<typename Iter>
+	Heap(Iter first, Iter last, const Compare& compare = Compare())
+		: _size(0), _data(ROOT), _compare(compare) {
+		assign(first, last);
+	}
+
+	// Replace the contents with a range in O(n) (Floyd's heapify) instead
+	// of n inserts at O(log n) each
+	template<typename Iter>
+	void assign(Iter first, Iter last) {
+		_data.erase(_data.begin() + ROOT, _data.end());
+		_data.insert(_data.end(), first, last);
+		_size = _data.size() - ROOT;
+		_heapify();
+	}
+
+	// Add a whole range at once. Swimming each new element costs up to one
+	// step per level, rebuilding costs O(n) regardless, so the batch is
+	// swum in when it is small and the heap is rebuilt when it is not.
+	template<typename Iter>
+	void insert_batch(Iter first, Iter last) {
+		// Slots past the end are left over from pops, drop them first
+		_data.erase(_data.begin() + ROOT + _size, _data.end());
+		size_t oldSize = _size;
+		_data.insert(_data.end(), first, last);
+		_size = _data.size() - ROOT;
+
+		size_t added = _size - oldSize;
+		if (added * _height() > _size) {
+			_heapify();
+		}	else	{
+			for (size_t index = ROOT + oldSize; index < ROOT + _size; index++)
+				_swimItr(index);
+		}
+	}
+
 	void insert(const T& ELEMENT) {
 		// insert the new element at the end of array
 
-		if (_size + 1 == _data.size())
+		if (ROOT + _size == _data.size())
 			_data.push_back(ELEMENT);
 		else
-			_data[_size + 1] = ELEMENT;
+			_data[ROOT + _size] = ELEMENT;
 
 
 		// Restore the heap property
-		// _swim(++_size);
-		_swimItr(++_size);
+		// _swim(ROOT + _size++);
+		_swimItr(ROOT + _size++);
 	}
 
 	const T pop() {
 		if (isEmpty()) throw std::runtime_error("No element in heap!");
 
-		// Swap with Last Value
-		T minValue = _data[1];
-		std::swap(_data[1], _data[_size--]);
+		// Move the Last Value to the root
+		T minValue = std::move(_data[ROOT]);
+		_data[ROOT] = std::move(_data[ROOT + --_size]);
 
 		// Restore Heap Property
-		// _sink(1);
-		_sinkItr(1);
+		// _sink(ROOT);
+		if (!isEmpty()) _sinkItr(ROOT);
 
 		// Return the min value
 		return minValue;
@@ -41,8 +116,16 @@ public:
 
 	const T& peak() const {
 		if (isEmpty()) throw std::runtime_error("No element in heap!");
-		return _data[0];
+		return _data[ROOT];
+	}
+
+	// pop() followed by insert(ELEMENT) with a single sink
+	void replace_top(const T& ELEMENT) {
+		if (isEmpty()) throw std::runtime_error("No element in heap!");
+		_data[ROOT] = ELEMENT;
+		_sinkItr(ROOT);
 	}
+
 	size_t size() const {return _size;}
 
 	bool isEmpty() const {
@@ -51,11 +134,37 @@ public:
 
 
 protected:
+	static const size_t ROOT = ARITY - 1;
+
+	static size_t _parentIndex(size_t index) {
+		return (index - ROOT - 1) / ARITY + ROOT;
+	}
+
+	static size_t _firstChildIndex(size_t index) {
+		return ARITY * (index - ROOT) + 1 + ROOT;
+	}
+
+	// Number of levels
+	size_t _height() const {
+		size_t height = 0;
+		for (size_t level = 1, total = 0; total < _size; level *= ARITY, height++)
+			total += level;
+		return height;
+	}
+
+	// Floyd: sink every internal node, last one first. Most nodes are near
+	// the bottom and only sink a level or two, which makes it O(n).
+	void _heapify() {
+		if (_size < 2) return;
+		for (size_t index = _parentIndex(ROOT + _size - 1) + 1; index-- > ROOT;)
+			_sinkItr(index);
+	}
+
 	void _swim(size_t index) {
 
-		if (index != 1) {
-			size_t parentIndex = index / 2;
-			if (_data[index] < _data[parentIndex]) {
+		if (index != ROOT) {
+			size_t parentIndex = _parentIndex(index);
+			if (_compare(_data[index], _data[parentIndex])) {
 				std::swap(_data[index], _data[parentIndex]);
 				_swim(parentIndex);
 			}
@@ -63,15 +172,20 @@ protected:
 		return;
 	}
 
+	// Rather than swapping at every level, the new element is held aside
+	// and the "hole" it leaves moves up: each larger parent is moved down
+	// into it, and the element is written once where the hole stops.
 	void _swimItr(size_t index) {
 
-		while (index != 1) {
-			size_t parentIndex = index / 2;
-			if (_data[index] < _data[parentIndex]) {
-				std::swap(_data[index], _data[parentIndex]);
+		T element = std::move(_data[index]);
+		while (index != ROOT) {
+			size_t parentIndex = _parentIndex(index);
+			if (_compare(element, _data[parentIndex])) {
+				_data[index] = std::move(_data[parentIndex]);
 				index = parentIndex;
 			} else break;
 		}
+		_data[index] = std::move(element);
 		return;
 	}
 
@@ -79,7 +193,7 @@ protected:
 
 		if (!_isLeaf(index)) {
 			size_t minChildIndex = _minChildIndex(index);
-			if (_data[index] > _data[minChildIndex]) {
+			if (_compare(_data[minChildIndex], _data[index])) {
 				std::swap(_data[index], _data[minChildIndex]);
 				_sink(minChildIndex);
 			}
@@ -87,50 +201,847 @@ protected:
 		return;
 	}
 
+	// Same idea as _swimItr: the hole moves down, smaller children move up
 	void _sinkItr(size_t index) {
 
+		T element = std::move(_data[index]);
 		while (!_isLeaf(index)) {
 			size_t minChildIndex = _minChildIndex(index);
-			if (_data[index] > _data[minChildIndex]) {
-				std::swap(_data[index], _data[minChildIndex]);
+			if (_compare(_data[minChildIndex], element)) {
+				_data[index] = std::move(_data[minChildIndex]);
 				index = minChildIndex;
 			} else break;
 		}
+		_data[index] = std::move(element);
 
 		return;
 	}
 
-	bool _isLeaf(size_t index) {
+	bool _isLeaf(size_t index) const {
 		// A leaf node has no children, so it is a leaf
-		// if the left child (index*2) is larger than the size
-		// of the heap
-		return index * 2 > _size;
+		// if its first child would be past the last element
+		return _firstChildIndex(index) >= ROOT + _size;
 	}
 
-	size_t _minChildIndex(size_t index) {
-		size_t left = index * 2;
-		size_t right = left + 1;
+	size_t _minChildIndex(size_t index) const {
+		size_t first = _firstChildIndex(index);
+		size_t last = std::min(first + ARITY, ROOT + _size);
 
-		if (right > _size) return left;
+		size_t minIndex = first;
+		if (last == first + ARITY) {
+			// Full sibling group: a fixed trip count and a select instead of
+			// a branch, which on random keys would be mispredicted half the time
+			for (size_t child = first + 1; child < first + ARITY; child++)
+				minIndex = _compare(_data[child], _data[minIndex]) ? child : minIndex;
+			return minIndex;
+		}
+		for (size_t child = first + 1; child < last; child++)
+			if (_compare(_data[child], _data[minIndex])) minIndex = child;
+
+		return minIndex;
+	}
+};
+
+// The original binary heap, which swaps the element at every level it
+// moves through. Kept as the baseline Heap is measured against.
+template<class T>
+class SwapHeap {
+	size_t _size;
+	std::vector<T> _data;
+
+	void _swimItr(size_t index) {
+		while (index != 1) {
+			size_t parentIndex = index / 2;
+			if (_data[index] < _data[parentIndex]) {
+				std::swap(_data[index], _data[parentIndex]);
+				index = parentIndex;
+			} else break;
+		}
+	}
+
+	void _sinkItr(size_t index) {
+		while (index * 2 <= _size) {
+			size_t minChildIndex = index * 2;
+			if (minChildIndex + 1 <= _size and _data[minChildIndex + 1] < _data[minChildIndex]) minChildIndex++;
+			if (_data[minChildIndex] < _data[index]) {
+				std::swap(_data[index], _data[minChildIndex]);
+				index = minChildIndex;
+			} else break;
+		}
+	}
 
-		if (_data[left] < _data[right]) return left;
+public:
+	SwapHeap()
+		: _size(0), _data(1)
+	{}
+
+	void insert(const T& ELEMENT) {
+		if (_size + 1 == _data.size())
+			_data.push_back(ELEMENT);
+		else
+			_data[_size + 1] = ELEMENT;
+		_swimItr(++_size);
+	}
 
-		return right;
+	const T pop() {
+		if (isEmpty()) throw std::runtime_error("No element in heap!");
+		T minValue = _data[1];
+		std::swap(_data[1], _data[_size--]);
+		_sinkItr(1);
+		return minValue;
+	}
+
+	size_t size() const {return _size;}
+
+	bool isEmpty() const {
+		return _size == 0;
 	}
 };
 
+// Addressable d-ary min heap
+// insert hands back a handle that stays attached to the element while it
+// moves around the heap, so its key can be changed or the element removed
+// later in O(log n) without searching for it. Each slot keeps its handle
+// next to the value, and every move during sifting records the new slot
+// in _position. A handle is released (and may be handed out again) once
+// its element is popped or erased.
+template<class T, size_t ARITY = 4>
+class IndexedHeap {
+public:
+	typedef size_t Handle;
+
+private:
+	class Entry {
+	public:
+		T value;
+		Handle handle;
+		Entry(const T& value, Handle handle)
+			: value(value), handle(handle)
+		{}
+	};
+
+	static const size_t ROOT = ARITY - 1;
+	static constexpr size_t NOT_IN_HEAP = SIZE_MAX;
+
+	// Slots before ROOT are never used, they only align sibling groups
+	std::vector<Entry> _data;
+	// _position[handle] is the slot holding that handle's element
+	std::vector<size_t> _position;
+	std::vector<Handle> _freeHandles;
+
+	size_t _last() const {
+		return _data.size() - 1;
+	}
+
+	static size_t _parentIndex(size_t index) {
+		return (index - ROOT - 1) / ARITY + ROOT;
+	}
+
+	static size_t _firstChildIndex(size_t index) {
+		return ARITY * (index - ROOT) + 1 + ROOT;
+	}
+
+	// Write entry into a slot and remember where its handle now is
+	void _place(size_t index, Entry&& entry) {
+		_position[entry.handle] = index;
+		_data[index] = std::move(entry);
+	}
+
+	void _swimItr(size_t index) {
+		Entry entry = std::move(_data[index]);
+		while (index != ROOT) {
+			size_t parentIndex = _parentIndex(index);
+			if (entry.value < _data[parentIndex].value) {
+				_place(index, std::move(_data[parentIndex]));
+				index = parentIndex;
+			} else break;
+		}
+		_place(index, std::move(entry));
+	}
+
+	void _sinkItr(size_t index) {
+		Entry entry = std::move(_data[index]);
+		while (true) {
+			size_t first = _firstChildIndex(index);
+			if (first > _last()) break;
+			size_t last = std::min(first + ARITY - 1, _last());
+			size_t minChildIndex = first;
+			for (size_t child = first + 1; child <= last; child++)
+				if (_data[child].value < _data[minChildIndex].value) minChildIndex = child;
+			if (_data[minChildIndex].value < entry.value) {
+				_place(index, std::move(_data[minChildIndex]));
+				index = minChildIndex;
+			} else break;
+		}
+		_place(index, std::move(entry));
+	}
+
+	size_t _slot(Handle handle) const {
+		if (!contains(handle)) throw std::invalid_argument("Handle is not in the heap");
+		return _position[handle];
+	}
+
+	// Take the element out of a slot, fill the gap with the last element
+	// and sift that one whichever way it has to go
+	T _removeAt(size_t index) {
+		T value = std::move(_data[index].value);
+		Handle handle = _data[index].handle;
+		_position[handle] = NOT_IN_HEAP;
+		_freeHandles.push_back(handle);
+
+		if (index != _last()) {
+			_place(index, std::move(_data.back()));
+			_data.pop_back();
+			if (index != ROOT and _data[index].value < _data[_parentIndex(index)].value) _swimItr(index);
+			else _sinkItr(index);
+		}	else	{
+			_data.pop_back();
+		}
+		return value;
+	}
+
+public:
+	IndexedHeap()
+		: _data(ROOT, Entry(T(), 0))
+	{}
+
+	Handle insert(const T& ELEMENT) {
+		Handle handle;
+		if (_freeHandles.empty()) {
+			handle = _position.size();
+			_position.push_back(NOT_IN_HEAP);
+		}	else	{
+			handle = _freeHandles.back();
+			_freeHandles.pop_back();
+		}
+		_data.emplace_back(ELEMENT, handle);
+		_swimItr(_last());
+		return handle;
+	}
+
+	const T pop() {
+		if (isEmpty()) throw std::runtime_error("No element in heap!");
+		return _removeAt(ROOT);
+	}
+
+	const T& peak() const {
+		if (isEmpty()) throw std::runtime_error("No element in heap!");
+		return _data[ROOT].value;
+	}
+
+	// Handle of the element peak() returns
+	Handle top() const {
+		if (isEmpty()) throw std::runtime_error("No element in heap!");
+		return _data[ROOT].handle;
+	}
+
+	const T& get(Handle handle) const {
+		return _data[_slot(handle)].value;
+	}
+
+	bool contains(Handle handle) const {
+		return handle < _position.size() and _position[handle] != NOT_IN_HEAP;
+	}
+
+	// Lower the key of an element O(log n), it can only move up
+	void decrease_key(Handle handle, const T& value) {
+		size_t index = _slot(handle);
+		if (_data[index].value < value) throw std::invalid_argument("decrease_key() would increase the key");
+		_data[index].value = value;
+		_swimItr(index);
+	}
+
+	// Raise the key of an element O(log n), it can only move down
+	void increase_key(Handle handle, const T& value) {
+		size_t index = _slot(handle);
+		if (value < _data[index].value) throw std::invalid_argument("increase_key() would decrease the key");
+		_data[index].value = value;
+		_sinkItr(index);
+	}
+
+	// Remove an arbitrary element O(log n)
+	const T erase(Handle handle) {
+		return _removeAt(_slot(handle));
+	}
+
+	size_t size() const {return _data.size() - ROOT;}
+
+	bool isEmpty() const {
+		return size() == 0;
+	}
+};
+
+template<class T, size_t ARITY = 4>
+using MaxHeap = Heap<T, ARITY, std::greater<T>>;
+
+// The K best elements of a stream (largest by Compare) in O(K) memory
+// They are kept in a heap whose root is the worst of them, so a new
+// element that does not beat the root is rejected with one comparison,
+// and one that does replaces the root in O(log K).
+template<class T, size_t K, class Compare = std::less<T>>
+class TopK {
+	static_assert(K > 0, "TopK needs room for at least one element");
+
+	Heap<T, 4, Compare> _kept;
+	Compare _compare;
+public:
+	explicit TopK(const Compare& compare = Compare())
+		: _kept(compare), _compare(compare)
+	{}
+
+	// Returns whether ELEMENT is now among the best K
+	bool offer(const T& ELEMENT) {
+		if (_kept.size() < K) {
+			_kept.insert(ELEMENT);
+			return true;
+		}
+		if (!_compare(_kept.peak(), ELEMENT)) return false;
+		_kept.replace_top(ELEMENT);
+		return true;
+	}
+
+	// The worst element kept, anything not better than it is rejected
+	// once K elements have been seen
+	const T& threshold() const {
+		return _kept.peak();
+	}
+
+	size_t size() const {return _kept.size();}
+
+	bool isEmpty() const {
+		return _kept.isEmpty();
+	}
+
+	// The kept elements, best first O(K log K)
+	std::vector<T> sorted() const {
+		Heap<T, 4, Compare> copy = _kept;
+		std::vector<T> best(copy.size());
+		for (size_t i = best.size(); i-- > 0;) best[i] = copy.pop();
+		return best;
+	}
+};
+
+// Radix heap for unsigned integer keys that never go below the last pop
+// (monotone), as in Dijkstra or an event clock. Keys are bucketed by the
+// highest bit in which they differ from the last popped key: bucket 0
+// holds keys equal to it, bucket b those whose highest differing bit is
+// b - 1. pop empties the first non-empty bucket by taking its minimum as
+// the new last key and spreading the rest into lower buckets. A key only
+// ever moves to lower buckets, so each operation is amortised O(log C)
+// for keys up to C, with no comparisons between elements at all.
 template<class T>
-class MaxHeap: public Heap<T> {
+class RadixHeap {
+	static_assert(std::is_integral<T>::value and std::is_unsigned<T>::value, "RadixHeap needs unsigned integer keys");
+
+	static const size_t BITS = sizeof(T) * 8;
+
+	size_t _size;
+	// Refilling bucket 0 does not change the contents, so peak() can do it
+	mutable T _last;
+	mutable std::vector<T> _buckets[BITS + 1];
+
+	// Bit length of key ^ last
+	static size_t _bucket(T key, T last) {
+		unsigned long long diff = key ^ last;
+#if defined(__GNUC__)
+		return diff ? 64 - __builtin_clzll(diff) : 0;
+#else
+		size_t bucket = 0;
+		while (diff) {
+			diff >>= 1;
+			bucket++;
+		}
+		return bucket;
+#endif
+	}
+
+	// Move the smallest keys into bucket 0
+	void _refill() const {
+		if (!_buckets[0].empty()) return;
+		size_t b = 1;
+		while (_buckets[b].empty()) b++;
+		std::vector<T>& bucket = _buckets[b];
+		_last = *std::min_element(bucket.begin(), bucket.end());
+		for (T key : bucket) _buckets[_bucket(key, _last)].push_back(key);
+		bucket.clear();
+	}
+
 public:
+	RadixHeap()
+		: _size(0), _last(0)
+	{}
+
 	void insert(const T& ELEMENT) {
-		Heap<T>::insert(ELEMENT * -1);
+		if (ELEMENT < _last) throw std::invalid_argument("RadixHeap keys must not go below the last popped key");
+		_buckets[_bucket(ELEMENT, _last)].push_back(ELEMENT);
+		_size++;
 	}
 
 	const T pop() {
-		return Heap<T>::pop() * -1;
+		if (isEmpty()) throw std::runtime_error("No element in heap!");
+		_refill();
+		_buckets[0].pop_back();
+		_size--;
+		return _last;
+	}
+
+	const T& peak() const {
+		if (isEmpty()) throw std::runtime_error("No element in heap!");
+		_refill();
+		return _last;
+	}
+
+	size_t size() const {return _size;}
+
+	bool isEmpty() const {
+		return _size == 0;
+	}
+};
+
+// Dijkstra on a grid shaped road network with lazy deletion: a shorter
+// distance pushes a new entry and stale entries are skipped when popped.
+// An entry packs (distance << 32 | vertex) into one key, which stays
+// monotone since every edge has a positive weight.
+template<class Queue>
+uint64_t grid_shortest_paths(const std::vector<uint32_t>& right, const std::vector<uint32_t>& down, size_t width) {
+	size_t vertices = right.size();
+	std::vector<uint32_t> distance(vertices, UINT32_MAX);
+	Queue frontier;
+	distance[0] = 0;
+	frontier.insert(0);
+	while (!frontier.isEmpty()) {
+		uint64_t entry = frontier.pop();
+		uint32_t d = entry >> 32;
+		size_t u = entry & UINT32_MAX;
+		if (d != distance[u]) continue;
+		auto relax = [&](size_t v, uint32_t weight) {
+			if (d + weight < distance[v]) {
+				distance[v] = d + weight;
+				frontier.insert((uint64_t) distance[v] << 32 | v);
+			}
+		};
+		// Roads are two-way: right/down weights are shared with left/up
+		if (u % width + 1 < width) relax(u + 1, right[u]);
+		if (u % width > 0) relax(u - 1, right[u - 1]);
+		if (u + width < vertices) relax(u + width, down[u]);
+		if (u >= width) relax(u - width, down[u - width]);
+	}
+	uint64_t total = 0;
+	for (uint32_t d : distance) total += d;
+	return total;
+}
+
+// Concurrent relaxed priority queue (MultiQueue)
+// Elements are spread over c * threads ordinary heaps, each behind its own
+// lock. push goes to a random heap. pop looks at two random heaps and
+// takes from the one with the better top, so threads rarely wait on each
+// other (a busy heap is skipped via try_lock rather than waited on).
+//
+// The price is that pop is only approximately the minimum. With m heaps
+// the element popped is expected to be among the O(m) best in the whole
+// queue, and with high probability among the O(m log m) best. The "two
+// choices" are what keep this bound; picking one heap at random would
+// let the error grow without limit.
+template<class T, class Compare = std::less<T>>
+class MultiQueue {
+	class alignas(64) Queue {
+	public:
+		std::mutex lock;
+		Heap<T, 4, Compare> heap;
+		// Read without the lock to skip empty heaps cheaply
+		std::atomic<size_t> size;
+		Queue(const Compare& compare)
+			: heap(compare), size(0)
+		{}
+	};
+
+	std::vector<Queue*> _queues;
+	Compare _compare;
+
+	size_t _pick() const {
+		static thread_local std::minstd_rand random(std::hash<std::thread::id>()(std::this_thread::get_id()));
+		return random() % _queues.size();
+	}
+
+	// Pop from a queue that is locked by the caller
+	static T _popLocked(Queue* queue) {
+		T value = queue->heap.pop();
+		queue->size.store(queue->heap.size(), std::memory_order_relaxed);
+		queue->lock.unlock();
+		return value;
+	}
+
+public:
+	// c heaps per thread, c = 2 to 4 is the usual trade between contention
+	// and how far pop can be from the true minimum
+	explicit MultiQueue(size_t threads, size_t c = 2, const Compare& compare = Compare())
+		: _compare(compare) {
+		size_t count = std::max<size_t>(2, c * threads);
+		for (size_t i = 0; i < count; i++) _queues.push_back(new Queue(compare));
+	}
+
+	MultiQueue(const MultiQueue&) = delete;
+	MultiQueue& operator=(const MultiQueue&) = delete;
+
+	~MultiQueue() {
+		for (Queue* queue : _queues) delete queue;
+	}
+
+	size_t queues() const {return _queues.size();}
+
+	void insert(const T& ELEMENT) {
+		while (true) {
+			Queue* queue = _queues[_pick()];
+			if (!queue->lock.try_lock()) continue;
+			queue->heap.insert(ELEMENT);
+			queue->size.store(queue->heap.size(), std::memory_order_relaxed);
+			queue->lock.unlock();
+			return;
+		}
+	}
+
+	// Take an element close to the minimum, false if every heap was empty
+	bool try_pop(T& out) {
+		for (size_t attempt = 0; attempt < 2 * _queues.size(); attempt++) {
+			Queue* first = _queues[_pick()];
+			Queue* second = _queues[_pick()];
+			if (first->size.load(std::memory_order_relaxed) == 0) std::swap(first, second);
+			if (first->size.load(std::memory_order_relaxed) == 0) continue;
+			if (!first->lock.try_lock()) continue;
+			if (second != first and second->size.load(std::memory_order_relaxed) != 0 and second->lock.try_lock()) {
+				// Both locked, keep the one with the better top
+				if (first->heap.isEmpty() or (!second->heap.isEmpty() and _compare(second->heap.peak(), first->heap.peak())))
+					std::swap(first, second);
+				second->lock.unlock();
+			}
+			if (first->heap.isEmpty()) {
+				first->lock.unlock();
+				continue;
+			}
+			out = _popLocked(first);
+			return true;
+		}
+		// Random picks kept missing, so the queue is (nearly) empty: sweep
+		for (Queue* queue : _queues) {
+			queue->lock.lock();
+			if (!queue->heap.isEmpty()) {
+				out = _popLocked(queue);
+				return true;
+			}
+			queue->lock.unlock();
+		}
+		return false;
+	}
+
+	// Only exact while no other thread is pushing or popping
+	size_t size() const {
+		size_t total = 0;
+		for (Queue* queue : _queues) total += queue->size.load(std::memory_order_relaxed);
+		return total;
+	}
+
+	bool isEmpty() const {
+		return size() == 0;
+	}
+};
+
+// One Heap behind one mutex, the baseline MultiQueue is measured against
+template<class T>
+class LockedHeap {
+	std::mutex _lock;
+	Heap<T> _heap;
+public:
+	void insert(const T& ELEMENT) {
+		std::lock_guard<std::mutex> guard(_lock);
+		_heap.insert(ELEMENT);
+	}
+
+	bool try_pop(T& out) {
+		std::lock_guard<std::mutex> guard(_lock);
+		if (_heap.isEmpty()) return false;
+		out = _heap.pop();
+		return true;
 	}
 };
 
+// threads workers each do ops operations, alternating insert and pop
+template<class Queue>
+void scheduler_workload(Queue& queue, int threads, int ops) {
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; t++) {
+		workers.emplace_back([&queue, ops, t] {
+			std::minstd_rand random(t + 1);
+			int value;
+			for (int i = 0; i < ops; i++) {
+				if (i % 2 == 0) queue.insert(random() % 1000000);
+				else queue.try_pop(value);
+			}
+		});
+	}
+	for (std::thread& worker : workers) worker.join();
+}
+
+// Hierarchical timing wheel
+// Time moves in whole ticks. Level 0 has one slot (a list of timers) per
+// tick for the next 2^SLOT_BITS ticks, and every level above covers
+// 2^SLOT_BITS slots of the level below. A timer goes to the lowest level
+// whose range reaches its deadline, in the slot given by that level's
+// digit of the deadline. Every time the lower levels wrap around, the
+// slot that the next level up now points at is emptied and its timers are
+// placed again, which drops each of them at least one level. Deadlines
+// beyond the top level wait in a Heap until they come within range.
+//
+// schedule and cancel are O(1) list operations (O(log n) for the far
+// future ones), and tick is O(1) amortised, since a timer is moved down
+// at most LEVELS - 1 times. A handle is only valid until its timer fires
+// or is cancelled, after that it may be handed out again.
+template<class T, size_t LEVELS = 4, size_t SLOT_BITS = 8>
+class TimingWheel {
+	static_assert(LEVELS > 0 and LEVELS * SLOT_BITS < 64, "TimingWheel range must fit in 64 bit ticks");
+
+public:
+	typedef size_t Handle;
+
+private:
+	static constexpr size_t SLOTS = size_t(1) << SLOT_BITS;
+	static constexpr size_t NONE = SIZE_MAX;
+	// Entry::slot for entries that are not in a slot's list
+	static constexpr size_t FREE = SIZE_MAX, IN_OVERFLOW = SIZE_MAX - 1, CANCELLED = SIZE_MAX - 2;
+
+	class Entry {
+	public:
+		uint64_t deadline;
+		T payload;
+		size_t slot, prev, next;
+		Entry(uint64_t deadline, const T& payload)
+			: deadline(deadline), payload(payload), slot(FREE), prev(NONE), next(NONE)
+		{}
+	};
+
+	uint64_t _now;
+	size_t _size;
+	std::vector<Entry> _entries;
+	std::vector<Handle> _freeHandles;
+	// First entry of every slot, level by level
+	std::vector<size_t> _heads;
+	// (deadline, handle) of timers beyond the wheel's range. Cancelled ones
+	// stay in until they come into range and are only released then.
+	Heap<std::pair<uint64_t, Handle>> _overflow;
+
+	void _link(Handle handle, size_t slot) {
+		Entry& entry = _entries[handle];
+		entry.slot = slot;
+		entry.prev = NONE;
+		entry.next = _heads[slot];
+		if (entry.next != NONE) _entries[entry.next].prev = handle;
+		_heads[slot] = handle;
+	}
+
+	void _unlink(Handle handle) {
+		Entry& entry = _entries[handle];
+		if (entry.prev != NONE) _entries[entry.prev].next = entry.next;
+		else _heads[entry.slot] = entry.next;
+		if (entry.next != NONE) _entries[entry.next].prev = entry.prev;
+	}
+
+	void _release(Handle handle) {
+		_entries[handle].slot = FREE;
+		_freeHandles.push_back(handle);
+	}
+
+	// Lowest level whose range, seen from now, reaches the deadline:
+	// the highest SLOT_BITS digit in which the two differ
+	void _place(Handle handle) {
+		uint64_t deadline = _entries[handle].deadline;
+		size_t level = 0;
+		while (level < LEVELS and (deadline ^ _now) >> (SLOT_BITS * (level + 1)) != 0) level++;
+		if (level == LEVELS) {
+			_entries[handle].slot = IN_OVERFLOW;
+			_overflow.insert({deadline, handle});
+			return;
+		}
+		_link(handle, level * SLOTS + (deadline >> (SLOT_BITS * level)) % SLOTS);
+	}
+
+	void _cascade(size_t slot) {
+		while (_heads[slot] != NONE) {
+			Handle handle = _heads[slot];
+			_unlink(handle);
+			_place(handle);
+		}
+	}
+
+public:
+	TimingWheel()
+		: _now(0), _size(0), _heads(LEVELS * SLOTS, NONE)
+	{}
+
+	// Fire payload delay ticks from now (on the next tick at the earliest)
+	Handle schedule(uint64_t delay, const T& payload) {
+		uint64_t deadline = _now + std::max<uint64_t>(delay, 1);
+		Handle handle;
+		if (_freeHandles.empty()) {
+			handle = _entries.size();
+			_entries.emplace_back(deadline, payload);
+		}	else	{
+			handle = _freeHandles.back();
+			_freeHandles.pop_back();
+			_entries[handle].deadline = deadline;
+			_entries[handle].payload = payload;
+		}
+		_place(handle);
+		_size++;
+		return handle;
+	}
+
+	// Returns whether the timer was still pending
+	bool cancel(Handle handle) {
+		if (!contains(handle)) return false;
+		Entry& entry = _entries[handle];
+		if (entry.slot == IN_OVERFLOW) {
+			entry.slot = CANCELLED;
+		}	else	{
+			_unlink(handle);
+			_release(handle);
+		}
+		_size--;
+		return true;
+	}
+
+	bool contains(Handle handle) const {
+		return handle < _entries.size() and _entries[handle].slot != FREE and _entries[handle].slot != CANCELLED;
+	}
+
+	// Advance one tick and call fire(payload) for every timer due now.
+	// fire may schedule and cancel timers.
+	template<class Fire>
+	void tick(Fire fire) {
+		_now++;
+		// Levels whose lower levels all just wrapped around, top one first
+		size_t level = 1;
+		while (level < LEVELS and _now % (uint64_t(1) << (SLOT_BITS * level)) == 0) level++;
+		while (--level > 0) _cascade(level * SLOTS + (_now >> (SLOT_BITS * level)) % SLOTS);
+
+		while (!_overflow.isEmpty() and (_overflow.peak().first ^ _now) >> (SLOT_BITS * LEVELS) == 0) {
+			Handle handle = _overflow.pop().second;
+			if (_entries[handle].slot == CANCELLED) _release(handle);
+			else _place(handle);
+		}
+
+		size_t slot = _now % SLOTS;
+		while (_heads[slot] != NONE) {
+			Handle handle = _heads[slot];
+			_unlink(handle);
+			T payload = std::move(_entries[handle].payload);
+			_release(handle);
+			_size--;
+			fire(payload);
+		}
+	}
+
+	uint64_t now() const {return _now;}
+
+	size_t size() const {return _size;}
+
+	bool isEmpty() const {
+		return _size == 0;
+	}
+};
+
+// The same interface on an IndexedHeap of deadlines, the baseline the
+// wheel is measured against: schedule, cancel and every timer that fires
+// cost O(log n)
+template<class T>
+class HeapTimers {
+public:
+	typedef typename IndexedHeap<uint64_t>::Handle Handle;
+
+private:
+	uint64_t _now;
+	IndexedHeap<uint64_t> _deadlines;
+	// Indexed by handle
+	std::vector<T> _payloads;
+
+public:
+	HeapTimers()
+		: _now(0)
+	{}
+
+	Handle schedule(uint64_t delay, const T& payload) {
+		Handle handle = _deadlines.insert(_now + std::max<uint64_t>(delay, 1));
+		if (handle >= _payloads.size()) _payloads.resize(handle + 1);
+		_payloads[handle] = payload;
+		return handle;
+	}
+
+	bool cancel(Handle handle) {
+		if (!_deadlines.contains(handle)) return false;
+		_deadlines.erase(handle);
+		return true;
+	}
+
+	template<class Fire>
+	void tick(Fire fire) {
+		_now++;
+		while (!_deadlines.isEmpty() and _deadlines.peak() <= _now) {
+			T payload = std::move(_payloads[_deadlines.top()]);
+			_deadlines.pop();
+			fire(payload);
+		}
+	}
+
+	uint64_t now() const {return _now;}
+
+	size_t size() const {return _deadlines.size();}
+
+	bool isEmpty() const {
+		return _deadlines.isEmpty();
+	}
+};
+
+// Idle timeouts of a server's connections, one tick per millisecond. Each
+// request on a connection cancels its timer and schedules a new one, so
+// nearly every timer is cancelled long before it fires. Returns the sum
+// of the ids of the connections that timed out.
+template<class Timers>
+uint64_t connection_trace(int ticks, int eventsPerTick, uint64_t timeout) {
+	typedef typename Timers::Handle Handle;
+	Timers timers;
+	std::vector<Handle> timerOf;
+	// Open connections, and where each one is in that list
+	std::vector<uint32_t> open;
+	std::vector<size_t> openIndex;
+	std::mt19937 random(17);
+	uint64_t timedOut = 0;
+
+	auto close = [&](uint32_t id) {
+		open[openIndex[id]] = open.back();
+		openIndex[open.back()] = openIndex[id];
+		open.pop_back();
+	};
+	for (int t = 0; t < ticks; t++) {
+		for (int e = 0; e < eventsPerTick; e++) {
+			uint32_t event = random() % 100;
+			if (event < 10 or open.empty()) {
+				uint32_t id = timerOf.size();
+				timerOf.push_back(timers.schedule(timeout + random() % 1000, id));
+				openIndex.push_back(open.size());
+				open.push_back(id);
+			}	else	{
+				uint32_t id = open[random() % open.size()];
+				timers.cancel(timerOf[id]);
+				if (event < 95) timerOf[id] = timers.schedule(timeout + random() % 1000, id);
+				else close(id);
+			}
+		}
+		timers.tick([&](uint32_t id) {
+			timedOut += id;
+			close(id);
+		});
+	}
+	return timedOut;
+}
+
 int main() {
 
 	Heap<int> heap;
@@ -162,7 +1073,257 @@ int main() {
 	std::cout << heap.pop() << std::endl;
 	std::cout << heap.pop() << std::endl;
 
-	return 0;
+	std::cout << " === Heap built from an array, then insert_batch() === " << '\n';
+	std::vector<int> numbers = {5, 3, 17, 10, 84, 19, 6, 22, 9};
+	Heap<int> built(numbers.begin(), numbers.end());
+	std::vector<int> few = {1, 100}, many = {-5, 50, 7, 2, 60, 0, 13, 44, 8, 31};
+	built.insert_batch(few.begin(), few.end());
+	built.insert_batch(many.begin(), many.end());
+	std::cout << built.size() << " <-- size\n";
+	while (!built.isEmpty()) std::cout << built.pop() << ' ';
+	std::cout << '\n';
+
+	std::cout << " === MaxHeap and TopK === " << '\n';
+	MaxHeap<std::string> names;
+	names.insert("Irtaza");
+	names.insert("Ahmad");
+	names.insert("Butt");
+	names.insert("Malik");
+	std::cout << names.pop() << ' ' << names.pop() << '\n';
+
+	// Leaderboard: the 5 highest scores of a long stream of (score, player)
+	TopK<std::pair<int, int>, 5> leaderboard;
+	std::mt19937 random(42);
+	size_t accepted = 0;
+	for (int event = 0; event < 1000000; event++)
+		accepted += leaderboard.offer({(int) (random() % 1000000), event});
+	for (auto& entry : leaderboard.sorted())
+		std::cout << entry.first << ':' << entry.second << ' ';
+	std::cout << "\naccepted " << accepted << " of 1000000\n";
+
+	// How far from the minimum does MultiQueue pop? Count, for every pop,
+	// how many smaller elements were still in the queue (its rank error).
+	std::cout << " === MultiQueue rank error === " << '\n';
+	{
+		MultiQueue<int> relaxed(4);
+		const int n = 100000;
+		std::vector<int> order(n);
+		for (int i = 0; i < n; i++) order[i] = i;
+		std::shuffle(order.begin(), order.end(), std::mt19937(3));
+		for (int value : order) relaxed.insert(value);
+		// Fenwick tree over the values still queued
+		std::vector<int> fenwick(n + 1, 0);
+		auto add = [&fenwick, n](int index, int delta) {for (index++; index <= n; index += index & -index) fenwick[index] += delta;};
+		auto smaller = [&fenwick](int index) {int count = 0; for (; index > 0; index -= index & -index) count += fenwick[index]; return count;};
+		for (int i = 0; i < n; i++) add(i, 1);
+		long long total = 0;
+		int worst = 0, value;
+		while (relaxed.try_pop(value)) {
+			int error = smaller(value);
+			total += error;
+			worst = std::max(worst, error);
+			add(value, -1);
+		}
+		std::cout << relaxed.queues() << " heaps, mean rank error " << (double) total / n << ", worst " << worst << '\n';
+	}
+
+	// Dijkstra with one heap entry per vertex: a shorter distance lowers
+	// the vertex's key in place instead of pushing a duplicate
+	std::cout << " === Dijkstra with decrease_key() === " << '\n';
+	const int vertices = 6;
+	std::vector<std::vector<std::pair<int, int>>> edges = {
+		{{1, 7}, {2, 9}, {5, 14}}, {{0, 7}, {2, 10}, {3, 15}}, {{0, 9}, {1, 10}, {3, 11}, {5, 2}},
+		{{1, 15}, {2, 11}, {4, 6}}, {{3, 6}, {5, 9}}, {{0, 14}, {2, 2}, {4, 9}}
+	};
+	IndexedHeap<std::pair<int, int>> frontier;
+	std::vector<IndexedHeap<std::pair<int, int>>::Handle> handles(vertices);
+	std::vector<int> distance(vertices, INT32_MAX);
+	distance[0] = 0;
+	for (int v = 0; v < vertices; v++) handles[v] = frontier.insert({distance[v], v});
+	while (!frontier.isEmpty()) {
+		int u = frontier.pop().second;
+		for (auto& edge : edges[u]) {
+			int v = edge.first;
+			if (frontier.contains(handles[v]) and distance[u] + edge.second < distance[v]) {
+				distance[v] = distance[u] + edge.second;
+				frontier.decrease_key(handles[v], {distance[v], v});
+			}
+		}
+	}
+	for (int v = 0; v < vertices; v++) std::cout << distance[v] << ' ';
+	std::cout << '\n';
+
+	std::cout << " === RadixHeap === " << '\n';
+	RadixHeap<unsigned> radix;
+	for (unsigned key : {5u, 3u, 17u, 10u, 84u, 19u, 6u, 22u, 9u}) radix.insert(key);
+	std::cout << radix.pop() << ' ' << radix.pop() << ' ';
+	radix.insert(7);
+	while (!radix.isEmpty()) std::cout << radix.pop() << ' ';
+	std::cout << '\n';
+
+	// Shortest paths from a corner of a grid of roads with random lengths
+	{
+		const size_t width = 1000, vertices = width * width;
+		std::vector<uint32_t> right(vertices), down(vertices);
+		std::mt19937 random(11);
+		for (size_t v = 0; v < vertices; v++) {
+			right[v] = 1 + random() % 1000;
+			down[v] = 1 + random() % 1000;
+		}
+		std::cout << "\n--- Dijkstra on a " << width << " x " << width << " grid ---";
+		uint64_t heapTotal, radixTotal;
+		{
+			Timer t("Heap<uint64_t>");
+			heapTotal = grid_shortest_paths<Heap<uint64_t>>(right, down, width);
+		}
+		{
+			Timer t("RadixHeap<uint64_t>");
+			radixTotal = grid_shortest_paths<RadixHeap<uint64_t>>(right, down, width);
+		}
+		std::cout << "same distances: " << (heapTotal == radixTotal) << '\n';
+	}
+
+	// Scheduler-style scaling: every worker alternates insert and pop
+	{
+		const int ops = 1000000;
+		int most = std::max(2u, std::thread::hardware_concurrency());
+		for (int threads = 1; threads <= 16 and threads <= 2 * most; threads *= 2) {
+			std::cout << "\n--- " << threads << " threads x " << ops << " ops ---";
+			LockedHeap<int> locked;
+			MultiQueue<int> relaxed(threads);
+			for (int i = 0; i < 100000; i++) {
+				locked.insert(i * 7);
+				relaxed.insert(i * 7);
+			}
+			{
+				Timer t("Heap + mutex");
+				scheduler_workload(locked, threads, ops);
+			}
+			{
+				Timer t("MultiQueue");
+				scheduler_workload(relaxed, threads, ops);
+			}
+		}
+	}
+
+	// Timers on a small wheel (2 levels of 16 slots, 256 ticks), anything
+	// further out goes through the overflow heap
+	{
+		std::cout << "\n--- TimingWheel ---\n";
+		TimingWheel<std::string, 2, 4> wheel;
+		wheel.schedule(3, "3");
+		wheel.schedule(40, "40");
+		auto dropped = wheel.schedule(20, "cancelled");
+		wheel.schedule(1000, "1000");
+		wheel.schedule(300, "300");
+		wheel.schedule(17, "17");
+		wheel.cancel(dropped);
+		while (!wheel.isEmpty()) {
+			wheel.tick([&](const std::string& name) {
+				std::cout << name << "@" << wheel.now() << ' ';
+			});
+		}
+		std::cout << '\n';
+	}
+
+	// Connection idle timeouts of 30s, 50 events per millisecond
+	{
+		const int ticks = 100000, eventsPerTick = 50;
+		std::cout << "\n--- " << ticks << " ticks x " << eventsPerTick << " connection events ---";
+		uint64_t heapTotal, wheelTotal;
+		{
+			Timer t("HeapTimers");
+			heapTotal = connection_trace<HeapTimers<uint32_t>>(ticks, eventsPerTick, 30000);
+		}
+		{
+			Timer t("TimingWheel");
+			wheelTotal = connection_trace<TimingWheel<uint32_t>>(ticks, eventsPerTick, 30000);
+		}
+		std::cout << "same timeouts: " << (heapTotal == wheelTotal) << '\n';
+	}
+
+	// Push n random values, then pop them all: the original swapping
+	// binary heap vs binary, 4-ary and 8-ary Heap
+	for (size_t n : {100000, 1000000, 4000000}) {
+		std::cout << "\n=== " << n << " elements ===";
+		std::vector<int> values(n);
+		std::mt19937 random(7);
+		for (int& value : values) value = random();
+		long long sumSwap = 0, sum2 = 0, sum4 = 0, sum8 = 0;
+		{
+			Timer t("SwapHeap<int> push + pop");
+			SwapHeap<int> original;
+			for (int value : values) original.insert(value);
+			while (!original.isEmpty()) sumSwap += original.pop();
+		}
+		{
+			Timer t("Heap<int, 2> push + pop");
+			Heap<int, 2> binary;
+			for (int value : values) binary.insert(value);
+			while (!binary.isEmpty()) sum2 += binary.pop();
+		}
+		{
+			Timer t("Heap<int, 4> push + pop");
+			Heap<int, 4> quaternary;
+			for (int value : values) quaternary.insert(value);
+			while (!quaternary.isEmpty()) sum4 += quaternary.pop();
+		}
+		{
+			Timer t("Heap<int, 8> push + pop");
+			Heap<int, 8> octonary;
+			for (int value : values) octonary.insert(value);
+			while (!octonary.isEmpty()) sum8 += octonary.pop();
+		}
+		std::cout << "same results: " << (sumSwap == sum2 and sum2 == sum4 and sum4 == sum8) << '\n';
+	}
+
+	// Building a heap: n inserts vs heapify, on random values and on
+	// descending ones (where every insert swims to the root), then adding a
+	// batch half the heap's size with inserts vs insert_batch
+	for (size_t n : {1000000, 4000000}) {
+		std::cout << "\n=== building from " << n << " elements ===";
+		std::vector<int> values(n), descending(n);
+		std::mt19937 random(7);
+		for (int& value : values) value = random();
+		for (size_t i = 0; i < n; i++) descending[i] = (int) (n - i);
+		long long tops = 0;
+		{
+			Timer t("Heap<int> n inserts, random");
+			Heap<int> inserted;
+			for (int value : values) inserted.insert(value);
+			tops += inserted.peak();
+		}
+		{
+			Timer t("Heap<int> heapify, random");
+			Heap<int> heapified(values.begin(), values.end());
+			tops -= heapified.peak();
+		}
+		{
+			Timer t("Heap<int> n inserts, descending");
+			Heap<int> inserted;
+			for (int value : descending) inserted.insert(value);
+			tops += inserted.peak();
+		}
+		{
+			Timer t("Heap<int> heapify, descending");
+			Heap<int> heapified(descending.begin(), descending.end());
+			tops -= heapified.peak();
+		}
+		auto half = descending.begin() + n / 2;
+		{
+			Timer t("Heap<int> n / 2 inserts into n / 2");
+			Heap<int> grown(descending.begin(), half);
+			for (auto it = half; it != descending.end(); ++it) grown.insert(*it);
+			tops += grown.peak();
+		}
+		{
+			Timer t("Heap<int> insert_batch of n / 2 into n / 2");
+			Heap<int> grown(descending.begin(), half);
+			grown.insert_batch(half, descending.end());
+			tops -= grown.peak();
+		}
+		std::cout << "same tops: " << (tops == 0) << '\n';
+	}
 
 	return 0;
 }
\ No newline at end of file
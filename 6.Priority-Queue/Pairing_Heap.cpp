@@ -0,0 +1,309 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <list>
+#include <functional>
+#include <chrono>
+#include <random>
+#include <cstdint>
+
+// Timer Class for benchmarking
+class Timer {
+	std::chrono::time_point<std::chrono::high_resolution_clock> start, end;
+	long long elapsed_time;
+	const char* str;
+public:
+	Timer(const char* _str = ""): str(_str) {
+		start = std::chrono::high_resolution_clock::now();
+
+	}
+	~Timer() {
+		end = std::chrono::high_resolution_clock::now();
+		elapsed_time = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+		std::cout << "\n" << str << " Elapsed Time: " << elapsed_time << "ms\n";
+	}
+
+};
+
+// Pairing heap, a meldable min heap (by Compare)
+// The heap is a tree where every node is no larger than its children,
+// stored as first child / next sibling links. insert and meld just link
+// two roots, the smaller one on top, so both are O(1). pop removes the
+// root and links its children back together in two passes (pairs left to
+// right, then the pairs right to left), which is amortised O(log n).
+// Nodes come from a per-heap pool, and meld hands the pool over together
+// with the nodes, so two heaps merge without copying or moving elements.
+template<class T, class Compare = std::less<T>>
+class PairingHeap {
+	class Node {
+	public:
+		T value;
+		Node *child, *sibling;
+		Node(const T& value)
+			: value(value), child(nullptr), sibling(nullptr)
+		{}
+	};
+
+	// Blocks of nodes that grow geometrically, freed nodes are recycled
+	// through a freelist chained through their own memory. Both the block
+	// list and the freelist can be spliced onto another pool in O(1).
+	class NodePool {
+		std::list<Node*> _blocks;
+		Node *_free, *_freeTail;
+		size_t _used, _capacity;
+
+		static constexpr size_t FIRST_BLOCK = 32, LARGEST_BLOCK = 4096;
+
+		static Node*& _next(Node* node) {
+			return *reinterpret_cast<Node**>(node);
+		}
+
+		void* _take() {
+			if (_free) {
+				Node* node = _free;
+				_free = _next(node);
+				if (_free == nullptr) _freeTail = nullptr;
+				return node;
+			}
+			if (_used == _capacity) {
+				_capacity = _capacity == 0 ? FIRST_BLOCK : 2 * _capacity < LARGEST_BLOCK ? 2 * _capacity : LARGEST_BLOCK;
+				_blocks.push_back(static_cast<Node*>(::operator new(_capacity * sizeof(Node))));
+				_used = 0;
+			}
+			return _blocks.back() + _used++;
+		}
+
+		void _giveBack(void* memory) {
+			Node* node = static_cast<Node*>(memory);
+			_next(node) = _free;
+			_free = node;
+			if (_freeTail == nullptr) _freeTail = node;
+		}
+
+	public:
+		NodePool()
+			: _free(nullptr), _freeTail(nullptr), _used(0), _capacity(0)
+		{}
+
+		NodePool(const NodePool&) = delete;
+		NodePool& operator=(const NodePool&) = delete;
+
+		Node* allocate(const T& value) {
+			void* memory = _take();
+			try {
+				return new(memory) Node(value);
+			}	catch (...)	{
+				_giveBack(memory);
+				throw;
+			}
+		}
+
+		void deallocate(Node* node) {
+			node->~Node();
+			_giveBack(node);
+		}
+
+		// Take over every block and free node of other O(1). The rest of
+		// other's current block is left unused.
+		void adopt(NodePool& other) {
+			_blocks.splice(_blocks.begin(), other._blocks);
+			if (other._free) {
+				_next(other._freeTail) = _free;
+				if (_free == nullptr) _freeTail = other._freeTail;
+				_free = other._free;
+			}
+			other._free = other._freeTail = nullptr;
+			other._used = other._capacity = 0;
+		}
+
+		void release() {
+			for (Node* block : _blocks) ::operator delete(block);
+			_blocks.clear();
+			_free = _freeTail = nullptr;
+			_used = _capacity = 0;
+		}
+
+		~NodePool() {
+			release();
+		}
+	};
+
+	Node* _root;
+	size_t _size;
+	NodePool _pool;
+	Compare _compare;
+
+	// Make the larger root the first child of the smaller one
+	Node* _link(Node* first, Node* second) {
+		if (_compare(second->value, first->value)) std::swap(first, second);
+		second->sibling = first->child;
+		first->child = second;
+		first->sibling = nullptr;
+		return first;
+	}
+
+	// Two pass pairing of a sibling list, iterative so long lists (after
+	// many inserts) cannot overflow the stack
+	Node* _combine(Node* first) {
+		// Pass 1: link neighbours pairwise, pushing each pair on a stack
+		// (chained through sibling) so pass 2 sees them right to left
+		Node* pairs = nullptr;
+		while (first) {
+			Node* second = first->sibling;
+			if (second == nullptr) {
+				first->sibling = pairs;
+				pairs = first;
+				break;
+			}
+			Node* rest = second->sibling;
+			Node* pair = _link(first, second);
+			pair->sibling = pairs;
+			pairs = pair;
+			first = rest;
+		}
+		// Pass 2: fold the pairs into one tree
+		Node* root = nullptr;
+		while (pairs) {
+			Node* next = pairs->sibling;
+			pairs->sibling = nullptr;
+			root = root ? _link(root, pairs) : pairs;
+			pairs = next;
+		}
+		return root;
+	}
+
+public:
+	explicit PairingHeap(const Compare& compare = Compare())
+		: _root(nullptr), _size(0), _compare(compare)
+	{}
+
+	PairingHeap(const PairingHeap&) = delete;
+	PairingHeap& operator=(const PairingHeap&) = delete;
+
+	// O(1)
+	void insert(const T& ELEMENT) {
+		Node* node = _pool.allocate(ELEMENT);
+		_root = _root ? _link(_root, node) : node;
+		_size++;
+	}
+
+	// Amortised O(log n)
+	const T pop() {
+		if (isEmpty()) throw std::runtime_error("No element in heap!");
+		T minValue = _root->value;
+		Node* old = _root;
+		_root = _combine(_root->child);
+		_pool.deallocate(old);
+		_size--;
+		return minValue;
+	}
+
+	const T& peak() const {
+		if (isEmpty()) throw std::runtime_error("No element in heap!");
+		return _root->value;
+	}
+
+	// Move every element of other into this heap O(1), other ends up empty
+	void meld(PairingHeap& other) {
+		if (&other == this) return;
+		_pool.adopt(other._pool);
+		if (other._root) _root = _root ? _link(_root, other._root) : other._root;
+		_size += other._size;
+		other._root = nullptr;
+		other._size = 0;
+	}
+
+	size_t size() const {return _size;}
+
+	bool isEmpty() const {
+		return _size == 0;
+	}
+
+	void clear() {
+		// Values may own resources, so destroy them before the blocks go.
+		// Children and siblings are pushed on a stack instead of recursing.
+		std::vector<Node*> stack;
+		if (_root) stack.push_back(_root);
+		while (!stack.empty()) {
+			Node* node = stack.back();
+			stack.pop_back();
+			if (node->child) stack.push_back(node->child);
+			if (node->sibling) stack.push_back(node->sibling);
+			node->~Node();
+		}
+		_pool.release();
+		_root = nullptr;
+		_size = 0;
+	}
+
+	~PairingHeap() {
+		clear();
+	}
+};
+
+int main() {
+
+	PairingHeap<int> heap;
+
+	std::cout << " === 10 calls to heap.insert() === " << '\n';
+	heap.insert(4);
+	heap.insert(10);
+	heap.insert(2);
+	heap.insert(22);
+	heap.insert(45);
+	heap.insert(18);
+	heap.insert(-8);
+	heap.insert(95);
+	heap.insert(-69);
+	heap.insert(42);
+
+	std::cout << heap.size() << " <-- size\n";
+
+	std::cout << " === 5 calls to heap.pop() === " << '\n';
+	for (int i = 0; i < 5; i++) std::cout << heap.pop() << ' ';
+	std::cout << '\n';
+
+	// Two workers' queues combined in one step
+	PairingHeap<int> other;
+	for (int value : {7, -3, 30, 12}) other.insert(value);
+	heap.meld(other);
+	std::cout << heap.size() << ' ' << other.size() << " <-- sizes after meld\n";
+	while (!heap.isEmpty()) std::cout << heap.pop() << ' ';
+	std::cout << '\n';
+
+	PairingHeap<std::string, std::greater<std::string>> names;
+	names.insert("Irtaza");
+	names.insert("Ahmad");
+	names.insert("Malik");
+	names.insert("Butt");
+	std::cout << names.pop() << ' ' << names.peak() << '\n';
+
+	// Rebalancing two shards: pop/insert loop vs meld
+	const int n = 1000000;
+	std::mt19937 random(5);
+	PairingHeap<int> left, right, target;
+	for (int i = 0; i < n; i++) {
+		left.insert(random());
+		right.insert(random());
+	}
+	{
+		Timer t("pop/insert loop");
+		while (!left.isEmpty()) target.insert(left.pop());
+	}
+	{
+		Timer t("meld");
+		target.meld(right);
+	}
+	long long previous = INT64_MIN;
+	bool sorted = true;
+	{
+		Timer t("pop everything");
+		while (!target.isEmpty()) {
+			int value = target.pop();
+			sorted = sorted and value >= previous;
+			previous = value;
+		}
+	}
+	std::cout << "sorted: " << sorted << '\n';
+	return 0;
+}
@@ -10,7 +10,7 @@ private:
 		TreeNode *left, *right;
 		size_t height;
 		TreeNode(const K& key, const D& data)
-			: key(key), data(data), left(nullptr), right(nullptr)
+			: key(key), data(data), left(nullptr), right(nullptr), height(0)
 		{}
 	};
 
@@ -89,29 +89,21 @@ private:
 		else return _find(key, cur->left);
 	}
 
-	void _iop_remove(TreeNode*& cur, TreeNode*& iop) {
-		if (iop->right != nullptr) {
+	// Unlink the IOP (the rightmost node under slot) and return it
+	TreeNode* _iop_remove(TreeNode*& slot) {
+		if (slot->right != nullptr) {
 			//Search Right and remove
-			_iop_remove(cur, iop->right);
+			TreeNode* iop = _iop_remove(slot->right);
 			// Ensure balance and update height of this ancestor
 			// on the way back up the call stack:
-			_ensureBalance(iop);
-			return;
+			_ensureBalance(slot);
+			return iop;
 		}
 
-		//Base Case
-		K temp_key = iop->key;
-		D temp_data = iop->data;
-
-		iop->key = cur->key;
-		iop->data = cur->data;
-
-
-		cur->key = temp_key;
-		cur->data = temp_data;
-
-		_remove(iop);
-		return;
+		//Base Case: no right child, so its left subtree takes its place
+		TreeNode* iop = slot;
+		slot = iop->left;
+		return iop;
 	}
 
 	void _remove(TreeNode*& node) {
@@ -142,8 +134,15 @@ private:
 		}
 		// Two-child remove
 		// We need to be little more carefull in this case
+		// The IOP is unlinked and put in the node's place, so no key or data
+		// is ever copied and references to other nodes stay valid
 		else {
-			_iop_remove(node, node->left);
+			TreeNode* iop = _iop_remove(node->left);
+			iop->left = node->left;
+			iop->right = node->right;
+			delete node;
+			node = iop;
+			_ensureBalance(node);
 			return;
 		}
 	}